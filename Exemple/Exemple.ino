@@ -6,13 +6,19 @@
 
 #include "Unity.h"
 
-// Déclaration des classes d'unités spécifiques
-DECLARE_UNITY_CLASS(Resistance, "Ω")
-DECLARE_UNITY_CLASS(Tension, "V")
-DECLARE_UNITY_CLASS(Courant, "A")
-DECLARE_UNITY_CLASS(Capacite, "F")
-DECLARE_UNITY_CLASS(Frequence, "Hz")
-DECLARE_UNITY_CLASS(Puissance, "W")
+// Déclaration des classes d'unités spécifiques (avec leur dimension SI)
+DECLARE_UNITY_CLASS(Resistance, "Ω", DimResistance)
+DECLARE_UNITY_CLASS(Tension, "V", DimTension)
+DECLARE_UNITY_CLASS(Courant, "A", DimCourant)
+DECLARE_UNITY_CLASS(Capacite, "F", DimCapacite)
+DECLARE_UNITY_CLASS(Frequence, "Hz", DimFrequence)
+DECLARE_UNITY_CLASS(Puissance, "W", DimPuissance)
+
+// Types obtenus par produit/quotient (R * I -> Tension, V * I -> Puissance...)
+DECLARE_UNITY_CANONIQUE(Resistance)
+DECLARE_UNITY_CANONIQUE(Tension)
+DECLARE_UNITY_CANONIQUE(Courant)
+DECLARE_UNITY_CANONIQUE(Puissance)
 
 void setup() {
   Serial.begin(115200);
@@ -84,15 +90,21 @@ void setup() {
   Serial.print("R1 + R2 = ");
   Serial.println(rTotal.afficher(3));
   
-  // Loi d'Ohm: V = R * I
-  Tension vCalc = Tension((float)r1 * (float)i1);
+  // Loi d'Ohm: V = R * I (dimensions vérifiées à la compilation)
+  Tension vCalc = r1 * i1;
   Serial.print("V = R1 * I1 = ");
   Serial.println(vCalc.afficher(3));
   
   // Division
-  Resistance rDiv = Resistance((float)v1 / (float)i1);
+  Resistance rDiv = v1 / i1;
   Serial.print("R = V1 / I1 = ");
   Serial.println(rDiv.afficher(3));
+
+  // Puissance: P = V * I
+  Puissance pCalc = v1 * i1;
+  Serial.print("P = V1 * I1 = ");
+  Serial.println(pCalc.afficher(3));
+  // Tension t = v1 + i1;  // Ne compile pas : dimensions différentes
   Serial.println();
   
   // 4. Comparaisons
@@ -245,20 +245,26 @@ void loop() {
     float courantAleatoire = random(1, 1000) / 1000000.0;
     float resistanceAleatoire = random(100, 10000);
     
-    Serial.println("\n--- MESURES PÉRIODIQUES ---");
-    Serial.print("Tension: ");
-    Serial.println(Tension::afficher(tensionAleatoire, 2));
+    // Rapport écrit directement dans Serial (sans String), par blocs de 64 octets
+    C_UNITY::SortieGroupee<64> rapport(Serial);
+    rapport.println("\n--- MESURES PÉRIODIQUES ---");
+    rapport.print("Tension: ");
+    Tension::afficher(rapport, tensionAleatoire, 2);
+    rapport.println();
     
-    Serial.print("Courant: ");
-    Serial.println(Courant::afficher(courantAleatoire, 6));
+    rapport.print("Courant: ");
+    Courant::afficher(rapport, courantAleatoire, 6);
+    rapport.println();
     
-    Serial.print("Résistance: ");
-    Serial.println(Resistance::afficher(resistanceAleatoire, 0));
+    rapport.print("Résistance: ");
+    Resistance::afficher(rapport, resistanceAleatoire, 0);
+    rapport.println();
     
     // Calcul de puissance (P = V × I)
     float puissance = tensionAleatoire * courantAleatoire;
-    Serial.print("Puissance: ");
-    Serial.println(Puissance::afficher(puissance, 3));
+    rapport.print("Puissance: ");
+    Puissance::afficher(rapport, puissance, 3);
+    rapport.println();
   }
   
   delay(100);
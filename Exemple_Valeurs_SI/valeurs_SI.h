@@ -13,6 +13,324 @@
 
 #include "Unity.h"
 
+// ============================================================================
+// SÉRIES NORMALISÉES E6 À E192 (RECHERCHE DE COMBINAISONS)
+// ============================================================================
+
+/**
+ * Valeurs normalisées CEI 60063, mantisses × 100 en flash (470 = 4.7).
+ * E6 et E12 sont extraites de E24, E48 et E96 de E192 (une valeur sur 4
+ * ou sur 2) : 432 octets pour les six séries.
+ */
+struct SeriesE {
+    enum { E6 = 6, E12 = 12, E24 = 24, E48 = 48, E96 = 96, E192 = 192 };
+
+    static bool valide(uint8_t serie) {
+        return serie == E6 || serie == E12 || serie == E24 || serie == E48 || serie == E96 || serie == E192;
+    }
+
+    // Mantisses de la série, lues de pas en pas (mantisse i : table()[i * pas(serie)])
+    static const uint16_t* table(uint8_t serie) { return serie <= E24 ? e24() : e192(); }
+    static uint8_t pas(uint8_t serie) { return serie <= E24 ? E24 / serie : E192 / serie; }
+
+    static uint16_t mantisse(uint8_t serie, uint8_t i) {
+        return pgm_read_word(&table(serie)[i * pas(serie)]);
+    }
+
+private:
+    static const uint16_t* e24() {
+        static const uint16_t t[] PROGMEM = {
+            100, 110, 120, 130, 150, 160, 180, 200, 220, 240, 270, 300,
+            330, 360, 390, 430, 470, 510, 560, 620, 680, 750, 820, 910
+        };
+        return t;
+    }
+
+    // 920 et non 919 : exception de la norme
+    static const uint16_t* e192() {
+        static const uint16_t t[] PROGMEM = {
+            100, 101, 102, 104, 105, 106, 107, 109, 110, 111, 113, 114, 115, 117, 118, 120,
+            121, 123, 124, 126, 127, 129, 130, 132, 133, 135, 137, 138, 140, 142, 143, 145,
+            147, 149, 150, 152, 154, 156, 158, 160, 162, 164, 165, 167, 169, 172, 174, 176,
+            178, 180, 182, 184, 187, 189, 191, 193, 196, 198, 200, 203, 205, 208, 210, 213,
+            215, 218, 221, 223, 226, 229, 232, 234, 237, 240, 243, 246, 249, 252, 255, 258,
+            261, 264, 267, 271, 274, 277, 280, 284, 287, 291, 294, 298, 301, 305, 309, 312,
+            316, 320, 324, 328, 332, 336, 340, 344, 348, 352, 357, 361, 365, 370, 374, 379,
+            383, 388, 392, 397, 402, 407, 412, 417, 422, 427, 432, 437, 442, 448, 453, 459,
+            464, 470, 475, 481, 487, 493, 499, 505, 511, 517, 523, 530, 536, 542, 549, 556,
+            562, 569, 576, 583, 590, 597, 604, 612, 619, 626, 634, 642, 649, 657, 665, 673,
+            681, 690, 698, 706, 715, 723, 732, 741, 750, 759, 768, 777, 787, 796, 806, 816,
+            825, 835, 845, 856, 866, 876, 887, 898, 909, 920, 931, 942, 953, 965, 976, 988
+        };
+        return t;
+    }
+};
+
+/**
+ * Montage de 1 à 3 composants : valeurs[0..nombre[, dans l'ordre du montage
+ * (PARALLELE_PUIS_SERIE : (valeurs[0] // valeurs[1]) + valeurs[2])
+ */
+struct CombinaisonE {
+    enum Montage {
+        SEUL,
+        SERIE,                 // a + b (+ c)
+        PARALLELE,             // a // b (// c)
+        PARALLELE_PUIS_SERIE,  // (a // b) + c
+        SERIE_PUIS_PARALLELE   // (a + b) // c
+    };
+
+    uint8_t nombre;   // 0 : aucune combinaison (cible nulle, série inconnue)
+    uint8_t montage;
+    float valeurs[3];
+    float total;
+    float ecart;      // Écart relatif (total - cible) / cible
+
+    /**
+     * "(4.7kΩ // 10kΩ) + 220Ω" (+ : en série, // : en parallèle), chaque
+     * valeur affichée par G (Resistance...)
+     */
+    template <class G>
+    size_t afficher(Print& sortie, int nbDecimal = 3) const {
+        const char* liaison = (montage == PARALLELE || montage == PARALLELE_PUIS_SERIE) ? " //" : " +";
+        bool mixte = montage == PARALLELE_PUIS_SERIE || montage == SERIE_PUIS_PARALLELE;
+        size_t n = 0;
+        for (uint8_t i = 0; i < nombre; i++) {
+            if (mixte && i == 0) n += sortie.print('(');
+            if (i == 2 && mixte) {
+                n += sortie.print(')');
+                liaison = montage == PARALLELE_PUIS_SERIE ? " +" : " //";
+            }
+            if (i > 0) n += sortie.print(liaison);
+            n += G::afficher(sortie, valeurs[i], nbDecimal);
+        }
+        return n;
+    }
+};
+
+/**
+ * Recherche de la combinaison de 1 à 3 valeurs d'une série la plus proche
+ * d'une cible, sans table ni allocation (utilisable sur AVR).
+ *
+ * Les valeurs de la gamme (decadeMin..decadeMax) sont parcourues dans
+ * l'ordre croissant sans être rangées en mémoire. Pour 2 composants, deux
+ * curseurs se rapprochent depuis les extrémités (O(N)) ; pour 3, le
+ * troisième composant fixe la cible des deux autres (O(N²)), et seules les
+ * valeurs pouvant encore approcher la cible sont parcourues.
+ *
+ * Le calcul est écrit pour des composants dont les valeurs s'ajoutent en
+ * série (résistances, inductances) ; sommeEnSerie = false (capacités)
+ * échange série et parallèle dans le montage trouvé.
+ */
+class RechercheE {
+public:
+    static const uint8_t NB_DECADES_MAX = 16;
+
+    RechercheE(uint8_t serie, int8_t decadeMin, int8_t decadeMax, bool sommeEnSerie = true)
+        : n(serie), table(SeriesE::table(serie)), pas(SeriesE::pas(serie)), nbValeurs(0), sommeEnSerie(sommeEnSerie) {
+        if (!SeriesE::valide(serie) || decadeMax < decadeMin) return;
+        int nbDecades = decadeMax - decadeMin + 1;
+        if (nbDecades > NB_DECADES_MAX) nbDecades = NB_DECADES_MAX;
+        for (int d = 0; d < nbDecades; d++) decades[d] = (float)(pow(10.0, decadeMin + d) / 100.0);
+        nbValeurs = (int16_t)(nbDecades * n);
+    }
+
+    /**
+     * La combinaison la moins nombreuse dans la tolérance relative (vrai),
+     * sinon la plus proche trouvée avec au plus nbMax composants (faux)
+     */
+    bool chercher(float cible, float tolerance, uint8_t nbMax, CombinaisonE& meilleure) const {
+        meilleure.nombre = 0;
+        meilleure.total = NAN;
+        meilleure.ecart = INFINITY;
+        if (!(cible > 0) || nbValeurs == 0) return false;
+
+        Evaluation e(cible, meilleure);
+        Curseur c;
+        int16_t k = premierAuDela(cible);
+
+        // Une valeur : les deux voisines de la cible
+        e.forme = CombinaisonE::SEUL;
+        if (k > 0) e.retenir(valeur(k - 1), 0, 0);
+        if (k < nbValeurs) e.retenir(valeur(k), 0, 0);
+
+        // Deux valeurs
+        if (nbMax >= 2 && fabsf(meilleure.ecart) > tolerance) {
+            e.forme = CombinaisonE::SERIE;
+            paires(cible, false, 0, nbValeurs - 1, e);
+            e.forme = CombinaisonE::PARALLELE;
+            paires(cible, true, 0, nbValeurs - 1, e);
+        }
+
+        // Trois valeurs : c fixé, a et b cherchés pour le reste
+        if (nbMax >= 3 && fabsf(meilleure.ecart) > tolerance) {
+            // a + b + c, a <= b <= c : c entre cible / 3 et cible
+            e.forme = CombinaisonE::SERIE;
+            int16_t debut = premierAuDela(cible / 3.0f);
+            for (placer(c, debut > 0 ? debut - 1 : 0); c.k < k; avancer(c)) {
+                e.c = c.v;
+                paires(cible - c.v, false, 0, c.k, e);
+            }
+            // a // b // c, c <= a <= b : c entre cible et 3 × cible
+            e.forme = CombinaisonE::PARALLELE;
+            for (placer(c, k); c.k < nbValeurs && c.v <= 3.0f * cible; avancer(c)) {
+                e.c = c.v;
+                paires(1.0f / (1.0f / cible - 1.0f / c.v), true, c.k, nbValeurs - 1, e);
+            }
+            // (a // b) + c : c < cible
+            e.forme = CombinaisonE::PARALLELE_PUIS_SERIE;
+            for (placer(c, 0); c.k < k; avancer(c)) {
+                e.c = c.v;
+                paires(cible - c.v, true, 0, nbValeurs - 1, e);
+            }
+            // (a + b) // c : c > cible
+            e.forme = CombinaisonE::SERIE_PUIS_PARALLELE;
+            for (placer(c, k); c.k < nbValeurs; avancer(c)) {
+                e.c = c.v;
+                paires(1.0f / (1.0f / cible - 1.0f / c.v), false, 0, nbValeurs - 1, e);
+            }
+        }
+
+        if (!sommeEnSerie) meilleure.montage = miroir(meilleure.montage);
+        return fabsf(meilleure.ecart) <= tolerance;
+    }
+
+    // Nombre de valeurs de la gamme (0 : série ou décades invalides)
+    int16_t taille() const { return nbValeurs; }
+
+    // k-ième valeur de la gamme, dans l'ordre croissant
+    float valeur(int16_t k) const {
+        return pgm_read_word(&table[(k % n) * pas]) * decades[k / n];
+    }
+
+private:
+    uint8_t n;
+    const uint16_t* table;
+    uint8_t pas;
+    int16_t nbValeurs;
+    bool sommeEnSerie;
+    float decades[NB_DECADES_MAX];  // 10^(decadeMin + d) / 100
+
+    // Position dans la gamme : la valeur suit sans division
+    struct Curseur {
+        int16_t k;
+        uint8_t i, d;
+        float v;
+    };
+
+    void placer(Curseur& c, int16_t k) const {
+        c.k = k;
+        c.i = c.d = 0;
+        c.v = 0;
+        if (k < 0 || k >= nbValeurs) return;
+        c.i = (uint8_t)(k % n);
+        c.d = (uint8_t)(k / n);
+        lire(c);
+    }
+
+    void avancer(Curseur& c) const {
+        c.k++;
+        if (++c.i == n) { c.i = 0; c.d++; }
+        if (c.k < nbValeurs) lire(c);
+    }
+
+    void reculer(Curseur& c) const {
+        c.k--;
+        if (c.i-- == 0) { c.i = n - 1; c.d--; }
+        if (c.k >= 0) lire(c);
+    }
+
+    void lire(Curseur& c) const { c.v = pgm_read_word(&table[c.i * pas]) * decades[c.d]; }
+
+    // Premier indice dont la valeur dépasse v (nbValeurs s'il n'y en a pas)
+    int16_t premierAuDela(float v) const {
+        int16_t bas = 0, haut = nbValeurs;
+        while (bas < haut) {
+            int16_t milieu = (int16_t)((bas + haut) / 2);
+            if (valeur(milieu) <= v) bas = (int16_t)(milieu + 1);
+            else haut = milieu;
+        }
+        return bas;
+    }
+
+    /**
+     * Retient le meilleur total d'un montage : c (fixé par l'appelant) et la
+     * paire (a, b) proposée
+     */
+    struct Evaluation {
+        float cible;
+        CombinaisonE& meilleure;
+        uint8_t forme;
+        float c;
+
+        Evaluation(float cible_, CombinaisonE& m) : cible(cible_), meilleure(m), forme(0), c(0) {}
+
+        void operator()(float a, float b) {
+            float total;
+            switch (forme) {
+                case CombinaisonE::SERIE:                total = c + a + b; break;
+                case CombinaisonE::PARALLELE:            total = 1.0f / (1.0f / a + 1.0f / b + (c > 0 ? 1.0f / c : 0.0f)); break;
+                case CombinaisonE::PARALLELE_PUIS_SERIE: total = c + 1.0f / (1.0f / a + 1.0f / b); break;
+                default:                                 total = 1.0f / (1.0f / (a + b) + 1.0f / c); break;
+            }
+            retenir(a, b, total);
+        }
+
+        void retenir(float a, float b, float total) {
+            if (forme == CombinaisonE::SEUL) total = a;
+            float ecart = (total - cible) / cible;
+            if (!(fabsf(ecart) < fabsf(meilleure.ecart))) return;
+            meilleure.nombre = forme == CombinaisonE::SEUL ? 1 : (c > 0 ? 3 : 2);
+            meilleure.montage = forme;
+            meilleure.valeurs[0] = a;
+            meilleure.valeurs[1] = b;
+            meilleure.valeurs[2] = c;
+            meilleure.total = total;
+            meilleure.ecart = ecart;
+        }
+    };
+
+    /**
+     * Paires a <= b d'indices [kMin, kMax] dont la somme (inverse = faux) ou
+     * le montage parallèle (inverse = vrai) approche r : à chaque pas, le
+     * curseur qui rapproche le total de r avance, jusqu'à ce qu'ils se croisent
+     */
+    void paires(float r, bool inverse, int16_t kMin, int16_t kMax, Evaluation& e) const {
+        if (!(r > 0)) return;
+        Curseur a, b;
+        if (!inverse) {
+            int16_t k = premierAuDela(r) - 1;  // b <= r
+            placer(a, kMin);
+            placer(b, k < kMax ? k : kMax);
+            while (a.k <= b.k) {
+                e(a.v, b.v);
+                if (a.v + b.v < r) avancer(a);
+                else reculer(b);
+            }
+        } else {
+            int16_t k = premierAuDela(r);      // a > r
+            float g = 1.0f / r;
+            placer(a, k > kMin ? k : kMin);
+            placer(b, kMax);
+            while (a.k <= b.k) {
+                e(a.v, b.v);
+                if (1.0f / a.v + 1.0f / b.v > g) avancer(a);
+                else reculer(b);
+            }
+        }
+    }
+
+    // Capacités : la somme se fait en parallèle
+    static uint8_t miroir(uint8_t montage) {
+        switch (montage) {
+            case CombinaisonE::SERIE:                return CombinaisonE::PARALLELE;
+            case CombinaisonE::PARALLELE:            return CombinaisonE::SERIE;
+            case CombinaisonE::PARALLELE_PUIS_SERIE: return CombinaisonE::SERIE_PUIS_PARALLELE;
+            case CombinaisonE::SERIE_PUIS_PARALLELE: return CombinaisonE::PARALLELE_PUIS_SERIE;
+            default:                                 return montage;
+        }
+    }
+};
+
 // ============================================================================
 // CLASSES AVEC MÉTHODES SPÉCIFIQUES (DÉFINIES MANUELLEMENT)
 // ============================================================================
@@ -20,35 +338,29 @@
 
 // Résistance électrique (Ohm)
 // Classe Resistance avec méthodes supplémentaires
-class Resistance : public C_UNITY {
+DECLARE_UNITY_UNITE(UniteOhm, "Ω", 1.0f)
+
+class Resistance : public Grandeur<DimResistance, UniteOhm> {
+    typedef Grandeur<DimResistance, UniteOhm> Base;
+
 public:
-    Resistance() : C_UNITY() {}
-    Resistance(float ohms) : C_UNITY(ohms) {}
-    
-    // Constructeur de copie
-    Resistance(const Resistance& other) : C_UNITY(other) {}
+    Resistance() : Base() {}
+    Resistance(float ohms) : Base(ohms) {}
+    Resistance(const Base& g) : Base(g) {}  // Résultat d'une opération typée
     
     // Opérateur d'affectation
     Resistance& operator=(float ohms) {
         valeur = ohms;
         return *this;
     }
-    
-    Resistance& operator=(const Resistance& other) {
-        if (this != &other) {
-            valeur = other.valeur;
-        }
-        return *this;
-    }
 
-    // Affichage
-    String afficher(int nbDecimal = 3) const {
-        return valeurAvecUnite("Ω", nbDecimal);
-    }
-    
-    static String afficher(float ohms, int nbDecimal = 3) {
-        return C_UNITY::valeurAvecUnite(ohms, "Ω", nbDecimal);
-    }
+    // Opérations typées avec les autres grandeurs (symbole() et afficher() hérités)
+    using Base::operator+;
+    using Base::operator-;
+    using Base::operator*;
+    using Base::operator/;
+    using Base::operator+=;
+    using Base::operator-=;
 
     // Opérateurs d'affectation composés
     Resistance& operator+=(const Resistance& other) {
@@ -138,37 +450,46 @@ public:
         }
         return inverseTotal != 0 ? 1.0 / inverseTotal : 0;
     }
+
+    /**
+     * Combinaison de 1 à nbMax résistances normalisées approchant ohms dans la
+     * tolérance relative (1 Ω à 9.88 MΩ par défaut) :
+     *   CombinaisonE c;
+     *   Resistance::chercherCombinaison(3140, c, SeriesE::E96, 1e-4);
+     *   c.afficher<Resistance>(Serial);    // " 130.000Ω + 3.010kΩ"
+     */
+    static bool chercherCombinaison(float ohms, CombinaisonE& resultat, uint8_t serie = SeriesE::E24,
+                                    float tolerance = 0.01f, uint8_t nbMax = 3, int8_t decadeMin = 0, int8_t decadeMax = 6) {
+        return RechercheE(serie, decadeMin, decadeMax).chercher(ohms, tolerance, nbMax, resultat);
+    }
 };
+DECLARE_UNITY_CANONIQUE(Resistance)
 
 // Capacité électrique (Farad)
 // Classe Capacite avec méthodes supplémentaires
-class Capacite : public C_UNITY {
-public:
-    Capacite() : C_UNITY() {}
-    Capacite(float farads) : C_UNITY(farads) {}
+DECLARE_UNITY_UNITE(UniteFarad, "F", 1.0f)
 
-    // Constructeur de copie
-    Capacite(const Capacite& other) : C_UNITY(other) {}
+class Capacite : public Grandeur<DimCapacite, UniteFarad> {
+    typedef Grandeur<DimCapacite, UniteFarad> Base;
+
+public:
+    Capacite() : Base() {}
+    Capacite(float farads) : Base(farads) {}
+    Capacite(const Base& g) : Base(g) {}  // Résultat d'une opération typée
     
     // Opérateur d'affectation
     Capacite& operator=(float farads) {
         valeur = farads;
         return *this;
     }
-    
-    Capacite& operator=(const Capacite& other) {
-        if (this != &other) valeur = other.valeur;
-        return *this;
-    }
-    
-    // Affichage
-    String afficher(int nbDecimal = 3) const {
-        return valeurAvecUnite("F", nbDecimal);
-    }
-    
-    static String afficher(float farads, int nbDecimal = 3) {
-        return C_UNITY::valeurAvecUnite(farads, "F", nbDecimal);
-    }
+
+    // Opérations typées avec les autres grandeurs (symbole() et afficher() hérités)
+    using Base::operator+;
+    using Base::operator-;
+    using Base::operator*;
+    using Base::operator/;
+    using Base::operator+=;
+    using Base::operator-=;
     
     // Opérateurs d'affectation composés
     Capacite& operator+=(const Capacite& other) {
@@ -258,37 +579,40 @@ public:
         }
         return total;
     }
+
+    // Idem pour les capacités (1 pF à 988 µF par défaut)
+    static bool chercherCombinaison(float farads, CombinaisonE& resultat, uint8_t serie = SeriesE::E12,
+                                    float tolerance = 0.01f, uint8_t nbMax = 3, int8_t decadeMin = -12, int8_t decadeMax = -4) {
+        return RechercheE(serie, decadeMin, decadeMax, false).chercher(farads, tolerance, nbMax, resultat);
+    }
 };
+DECLARE_UNITY_CANONIQUE(Capacite)
+
 // Inductance (Henry)
 // Classe Inductance avec méthodes supplémentaires
-class Inductance : public C_UNITY {
+DECLARE_UNITY_UNITE(UniteHenry, "H", 1.0f)
+
+class Inductance : public Grandeur<DimInductance, UniteHenry> {
+    typedef Grandeur<DimInductance, UniteHenry> Base;
+
 public:
-    Inductance() : C_UNITY() {}
-    Inductance(float henrys) : C_UNITY(henrys) {}
-    
-     // Constructeur de copie
-    Inductance(const Inductance& other) : C_UNITY(other) {}
+    Inductance() : Base() {}
+    Inductance(float henrys) : Base(henrys) {}
+    Inductance(const Base& g) : Base(g) {}  // Résultat d'une opération typée
     
     // Opérateur d'affectation
     Inductance& operator=(float henrys) {
         valeur = henrys;
         return *this;
     }
-    
-    Inductance& operator=(const Inductance& other) {
-        if (this != &other) {
-            valeur = other.valeur;
-        }
-        return *this;
-    }
-     // Affichage
-    String afficher(int nbDecimal = 3) const {
-        return valeurAvecUnite("H", nbDecimal);
-    }
 
-    static String afficher(float henrys, int nbDecimal = 3) {
-        return C_UNITY::valeurAvecUnite(henrys, "H", nbDecimal);
-    }
+    // Opérations typées avec les autres grandeurs (symbole() et afficher() hérités)
+    using Base::operator+;
+    using Base::operator-;
+    using Base::operator*;
+    using Base::operator/;
+    using Base::operator+=;
+    using Base::operator-=;
     
     // Opérateurs d'affectation composés
     Inductance& operator+=(const Inductance& other) {
@@ -378,7 +702,14 @@ public:
         }
         return total;
     }
+
+    // Idem pour les inductances (1 nH à 98.8 mH par défaut)
+    static bool chercherCombinaison(float henrys, CombinaisonE& resultat, uint8_t serie = SeriesE::E12,
+                                    float tolerance = 0.01f, uint8_t nbMax = 3, int8_t decadeMin = -9, int8_t decadeMax = -2) {
+        return RechercheE(serie, decadeMin, decadeMax).chercher(henrys, tolerance, nbMax, resultat);
+    }
 };
+DECLARE_UNITY_CANONIQUE(Inductance)
 
 // ============================================================================
 // CLASSES SANS UNITÉS C_UNITY (SANS HÉRITAGE DE C_UNITY)
@@ -386,32 +717,37 @@ public:
 #define __Kelvin__  true
 #define __Celsius__ false
 
+// Unité de stockage (Kelvin), pour le répertoire des unités
+DECLARE_UNITY_UNITE(Temperature_KC_Unite, "K", 1.0f)
+
 class Temperature_KC {
 private:
-    float valeur; // en Kelvin par défaut
-    bool enKelvin; // true = Kelvin, false = Celsius
+    float valeur; // toujours en Kelvin : conversion et affichage sans test d'échelle
 
 public:
-    // Constructeurs
-    Temperature_KC() : valeur(0.0), enKelvin(true) {}
-    Temperature_KC(float val, bool isKelvin = true) : valeur(val), enKelvin(isKelvin) {}
+    typedef Temperature_KC_Unite Unite;
+    typedef DimTemperature Dim;
+
+    // Constructeurs (une valeur en Celsius est convertie une fois, ici)
+    Temperature_KC() : valeur(0.0) {}
+    Temperature_KC(float val, bool isKelvin = true) : valeur(isKelvin ? val : celsiusToKelvin(val)) {}
     
     // Méthodes d'accès
-    float getValeur() const { return valeur; }
-    bool isKelvin() const { return enKelvin; }
+    float getValeur() const { return valeur; } // en Kelvin
+    bool isKelvin() const { return true; }     // stockage toujours en Kelvin
     
     // Opérateur de conversion vers float
     operator float() const {
-        return enKelvin ? valeur : valeur + C_UNITY::KELVIN_OFFSET;
+        return valeur;
     }
     
     // Méthodes d'instance
     String kelvin(int nbDecimal = 2) const {
-        return String((float)(*this), nbDecimal) + "°K";
+        return String(valeur, nbDecimal) + "°K";
     }
     
     String celsius(int nbDecimal = 2) const {
-        return String(enKelvin ? valeur - C_UNITY::KELVIN_OFFSET : valeur, nbDecimal) + "°C";
+        return String(kelvinToCelsius(valeur), nbDecimal) + "°C";
     }
     
     // Méthodes statiques
@@ -425,19 +761,37 @@ public:
     
     // Conversion entre échelles
     static float celsiusToKelvin(float celsius) {
-        return celsius + C_UNITY::KELVIN_OFFSET;
+        return celsius + (float)C_UNITY::KELVIN_OFFSET;
     }
     
     static float kelvinToCelsius(float kelvin) {
-        return kelvin - C_UNITY::KELVIN_OFFSET;
+        return kelvin - (float)C_UNITY::KELVIN_OFFSET;
     }
     
     static float celsiusToFahrenheit(float celsius) {
-        return (celsius * 9.0/5.0) + 32.0;
+        return celsius * (9.0f / 5.0f) + 32.0f;
     }
     
     static float fahrenheitToCelsius(float fahrenheit) {
-        return (fahrenheit - 32.0) * 5.0/9.0;
+        return (fahrenheit - 32.0f) * (5.0f / 9.0f);
+    }
+
+    // Conversion de tableaux (de et vers peuvent être le même tableau) :
+    // boucles sans test que le compilateur vectorise
+    static void celsiusToKelvin(const float* de, float* vers, size_t n) {
+        for (size_t i = 0; i < n; i++) vers[i] = celsiusToKelvin(de[i]);
+    }
+
+    static void kelvinToCelsius(const float* de, float* vers, size_t n) {
+        for (size_t i = 0; i < n; i++) vers[i] = kelvinToCelsius(de[i]);
+    }
+
+    static void celsiusToFahrenheit(const float* de, float* vers, size_t n) {
+        for (size_t i = 0; i < n; i++) vers[i] = celsiusToFahrenheit(de[i]);
+    }
+
+    static void fahrenheitToCelsius(const float* de, float* vers, size_t n) {
+        for (size_t i = 0; i < n; i++) vers[i] = fahrenheitToCelsius(de[i]);
     }
 };
 //-------------------
@@ -446,26 +800,33 @@ public:
 #define __Radians__  true
 #define __Degres__   false
 
+// Unité de stockage (radian), pour le répertoire des unités
+DECLARE_UNITY_UNITE(Angle_Unite, "rad", 1.0f)
+
 class Angle {
 private:
-    float valeur; // en radians par défaut
-    bool enRadians; // true = radians, false = degrés
+    float valeur; // toujours en radians
 
 public:
-    Angle() : valeur(0.0), enRadians(true) {}
-    Angle(float val, bool isRadians = true) : valeur(val), enRadians(isRadians) {}
+    typedef Angle_Unite Unite;
+    typedef DimSansDimension Dim;
+
+    Angle() : valeur(0.0) {}
+    Angle(float val, bool isRadians = true) : valeur(isRadians ? val : degresToRadians(val)) {}
+
+    float getValeur() const { return valeur; } // en radians
     
     // Opérateur de conversion vers float (toujours en radians)
     operator float() const {
-        return enRadians ? valeur : valeur * C_UNITY::PI_ / 180.0;
+        return valeur;
     }
     
     String radian(int nbDecimal = 3) const {
-        return String((float)(*this), nbDecimal) + " rad";
+        return String(valeur, nbDecimal) + " rad";
     }
     
     String degre(int nbDecimal = 3) const {
-        return String(enRadians ? valeur * 180.0 / C_UNITY::PI_ : valeur, nbDecimal) + "°";
+        return String(radiansToDegres(valeur), nbDecimal) + "°";
     }
     
     static String radian(float radians, int nbDecimal = 3) {
@@ -478,154 +839,518 @@ public:
     
     // Conversion entre unités
     static float degresToRadians(float degres) {
-        return degres * C_UNITY::PI_ / 180.0;
+        return degres * (float)(C_UNITY::PI_ / 180.0);
     }
     
     static float radiansToDegres(float radians) {
-        return radians * 180.0 / C_UNITY::PI_;
+        return radians * (float)(180.0 / C_UNITY::PI_);
+    }
+
+    // Conversion de tableaux (de et vers peuvent être le même tableau)
+    static void degresToRadians(const float* de, float* vers, size_t n) {
+        for (size_t i = 0; i < n; i++) vers[i] = degresToRadians(de[i]);
+    }
+
+    static void radiansToDegres(const float* de, float* vers, size_t n) {
+        for (size_t i = 0; i < n; i++) vers[i] = radiansToDegres(de[i]);
+    }
+
+    // ------------------------------------------------------------------------
+    // Trigonométrie rapide en float, sans branchement ni table : réduction à
+    // [-π/4, π/4] en trois morceaux de π/2 et polynômes minimax de Cephes
+    // pour sin et cos ; polynôme d'Abramowitz et Stegun 4.4.49 (degré 17,
+    // sur [0, 1]) pour atan2.
+    //   sin, cos : erreur absolue < 1.2e-7 pour |x| ≤ 1e4 rad
+    //   atan2    : erreur absolue < 4e-7 rad (moins de 2 ulp de π), atan2(0, 0) = 0
+    // Au-delà de 1e4 rad la réduction perd des chiffres ; NaN et infini ne
+    // sont pas traités (résultat quelconque). Sans FPU (AVR), ces fonctions
+    // évitent surtout les cas particuliers et la réduction en double de la libm.
+    // ------------------------------------------------------------------------
+    static void sinCosRapide(float x, float& s, float& c) {
+        const float DEUX_SUR_PI = 0.63661977236758134f;
+        const float PI_2_A = 1.5703125f, PI_2_B = 4.837512969970703125e-4f, PI_2_C = 7.54978995489188e-8f;
+        const float ARRONDI = 12582912.0f;                     // 1.5 × 2^23 : arrondi à l'entier
+        float q = (x * DEUX_SUR_PI + ARRONDI) - ARRONDI;       // quadrant le plus proche
+        int32_t k = (int32_t)q;
+        float r = ((x - q * PI_2_A) - q * PI_2_B) - q * PI_2_C;
+        float r2 = r * r;
+        float ps = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+        float pc = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+        float sq = (k & 1) ? pc : ps;
+        float cq = (k & 1) ? ps : pc;
+        s = (k & 2) ? -sq : sq;
+        c = ((k + 1) & 2) ? -cq : cq;
+    }
+
+    static float sinRapide(float x) { float s, c; sinCosRapide(x, s, c); return s; }
+    static float cosRapide(float x) { float s, c; sinCosRapide(x, s, c); return c; }
+
+    static float atan2Rapide(float y, float x) {
+        const float PI_2 = 1.57079632679489662f;
+        float ax = fabsf(x), ay = fabsf(y);
+        float grand = ax > ay ? ax : ay, petit = ax > ay ? ay : ax;
+        float t = petit / (grand + 1.17549435e-38f);           // [0, 1] ; + FLT_MIN : 0 / 0 évité sans test
+        float t2 = t * t;
+        float a = t + t * t2 * (-0.3333314528f + t2 * (0.1999355085f + t2 * (-0.1420889944f + t2 * (0.1065626393f
+                + t2 * (-0.0752896400f + t2 * (0.0429096138f + t2 * (-0.0161657367f + t2 * 0.0028662257f)))))));
+        // Octant puis quadrant : choix entre constantes, que le compilateur
+        // traduit en masques (une soustraction conditionnelle resterait un saut)
+        a = (ay > ax ? PI_2 : 0.0f) + (ay > ax ? -a : a);
+        a = (x < 0 ? 2.0f * PI_2 : 0.0f) + (x < 0 ? -a : a);
+        return y < 0 ? -a : a;
+    }
+
+    // Tableaux : boucles sans branchement, vectorisées par le compilateur
+    static void sinCosRapide(const float* x, float* s, float* c, size_t n) {
+        for (size_t i = 0; i < n; i++) sinCosRapide(x[i], s[i], c[i]);
+    }
+
+    static void atan2Rapide(const float* y, const float* x, float* a, size_t n) {
+        for (size_t i = 0; i < n; i++) a[i] = atan2Rapide(y[i], x[i]);
     }
 };
 
 // ============================================================================
 // CLASSES SPÉCIFIQUES PAR TYPE D'UNITÉ (GÉNÉRÉES PAR MACRO)
 // ============================================================================
+// DECLARE_UNITY_CLASS(Nom, "symbole", Dimension[, facteur vers l'unité SI])
+// Le facteur sert aux conversions typées, calculées à la compilation :
+//   convertir<ChampMagnetique>(ChampMagnetique_Gauss(1200));   // 0.12 T
+//   convertir<PressionAtmospherique>(Pression_mmHg(760));      // 1013.25 hPa
 
 //Grandeurs Électriques et Magnétiques
-DECLARE_UNITY_CLASS(Tension, "V")             // Tension électrique (Volt)
-DECLARE_UNITY_CLASS(Courant, "A")             // Courant électrique (Ampère)
-DECLARE_UNITY_CLASS(Conductance, "S")         // Conductance électrique (Siemens)
-DECLARE_UNITY_CLASS(ChampMagnetique, "T")     // Induction magnétique (Tesla)
-DECLARE_UNITY_CLASS(FluxMagnetique, "Wb")     // Flux magnétique (Weber)
-DECLARE_UNITY_CLASS(ChargeElectrique, "C")    // Charge électrique (Coulomb)
-DECLARE_UNITY_CLASS(Conductivite, "S/m")      // Conductivité électrique (Siemens par mètre)
-DECLARE_UNITY_CLASS(Resistivite, "Ω·m")       // Résistivité électrique (Ohm-mètre)
+DECLARE_UNITY_CLASS(Tension, "V", DimTension)                                   // Tension électrique (Volt)
+DECLARE_UNITY_CLASS(Courant, "A", DimCourant)                                   // Courant électrique (Ampère)
+DECLARE_UNITY_CLASS(Conductance, "S", DimConductance)                           // Conductance électrique (Siemens)
+DECLARE_UNITY_CLASS(ChampMagnetique, "T", DimChampMagnetique)                   // Induction magnétique (Tesla)
+DECLARE_UNITY_CLASS(FluxMagnetique, "Wb", DimFluxMagnetique)                    // Flux magnétique (Weber)
+DECLARE_UNITY_CLASS(ChargeElectrique, "C", DimCharge)                           // Charge électrique (Coulomb)
+DECLARE_UNITY_CLASS(Conductivite, "S/m", DimConductivite)                       // Conductivité électrique (Siemens par mètre)
+DECLARE_UNITY_CLASS(Resistivite, "Ω·m", DimResistivite)                         // Résistivité électrique (Ohm-mètre)
 
 // Grandeurs Énergétiques et Puissances
-DECLARE_UNITY_CLASS(Energie, "J")             // Énergie (Joule)
-DECLARE_UNITY_CLASS(Puissance, "W")           // Puissance active (P) (Watt)
-DECLARE_UNITY_CLASS(PuissanceApparente, "VA") // Puissance apparente (S)
-DECLARE_UNITY_CLASS(PuissanceReactive, "VAr") // Puissance réactive (Q)
-DECLARE_UNITY_CLASS(PuissanceDeformante, "VAD") // Puissance déformante (D)
-DECLARE_UNITY_CLASS(EnergieKWh, "kWh")        // Énergie électrique consommée (compteur)
-DECLARE_UNITY_CLASS(Energie_Calorie, "cal")       // Calorie (4.184 J)
-DECLARE_UNITY_CLASS(Puissance_Cheval, "ch")       // Cheval-vapeur (≈735.5 W)
-DECLARE_UNITY_CLASS(Energie_Thermie, "th")   // Thermie = 4.1855 MJ
-DECLARE_UNITY_CLASS(DensiteEnergie, "J/m³")   // Densité d'énergie volumique
-DECLARE_UNITY_CLASS(DensitePuissance, "W/m²") // Densité de puissance surfacique
+DECLARE_UNITY_CLASS(Energie, "J", DimEnergie)                                   // Énergie (Joule)
+DECLARE_UNITY_CLASS(Puissance, "W", DimPuissance)                               // Puissance active (P) (Watt)
+DECLARE_UNITY_CLASS(PuissanceApparente, "VA", DimPuissance)                     // Puissance apparente (S)
+DECLARE_UNITY_CLASS(PuissanceReactive, "VAr", DimPuissance)                     // Puissance réactive (Q)
+DECLARE_UNITY_CLASS(PuissanceDeformante, "VAD", DimPuissance)                   // Puissance déformante (D)
+DECLARE_UNITY_CLASS(EnergieKWh, "kWh", DimEnergie, 3.6e6f)                      // Énergie électrique consommée (compteur)
+DECLARE_UNITY_CLASS(Energie_Calorie, "cal", DimEnergie, 4.184f)                 // Calorie (4.184 J)
+DECLARE_UNITY_CLASS(Puissance_Cheval, "ch", DimPuissance, 735.49875f)           // Cheval-vapeur (≈735.5 W)
+DECLARE_UNITY_CLASS(Energie_Thermie, "th", DimEnergie, 4.1855e6f)               // Thermie = 4.1855 MJ
+DECLARE_UNITY_CLASS(DensiteEnergie, "J/m³", DimPression)                        // Densité d'énergie volumique
+DECLARE_UNITY_CLASS(DensitePuissance, "W/m²", DimDensitePuissance)              // Densité de puissance surfacique
 
 // Grandeurs Électriques Avancées (pour le monitoring énergétique)
 //DECLARE_UNITY_CLASS(FacteurPuissance, "")     // Facteur de puissance (cos φ, sans dimension, 0 à 1)
-DECLARE_UNITY_CLASS(CosPhi, "cos φ")          // Facteur de puissance (cosinus phi)
-DECLARE_UNITY_CLASS(Lambda, "λ") // Facteur de puissance en présence d'harmoniques
-DECLARE_UNITY_CLASS(TauxHarmonique, "%")      // Taux de distorsion harmonique (THD)
-DECLARE_UNITY_CLASS(TensionDC, "V")           // Tension continue (pour systèmes solaires/batteries)
-DECLARE_UNITY_CLASS(CourantDC, "A")           // Courant continu
-DECLARE_UNITY_CLASS(NiveauBatterie, "%")      // État de charge (State of Charge)
+DECLARE_UNITY_CLASS(CosPhi, "cos φ", DimSansDimension)                          // Facteur de puissance (cosinus phi)
+DECLARE_UNITY_CLASS(Lambda, "λ", DimSansDimension)                              // Facteur de puissance en présence d'harmoniques
+DECLARE_UNITY_CLASS(TauxHarmonique, "%", DimSansDimension, 0.01f)               // Taux de distorsion harmonique (THD)
+DECLARE_UNITY_CLASS(TensionDC, "V", DimTension)                                 // Tension continue (pour systèmes solaires/batteries)
+DECLARE_UNITY_CLASS(CourantDC, "A", DimCourant)                                 // Courant continu
+DECLARE_UNITY_CLASS(NiveauBatterie, "%", DimSansDimension, 0.01f)               // État de charge (State of Charge)
 
 // Standards IEEE courants
-DECLARE_UNITY_CLASS(Tension_RMS, "V")                // IEEE 1459 - Mesures d'énergie
-DECLARE_UNITY_CLASS(THD, "%")                        // IEEE 519 - Distorsion harmonique
-DECLARE_UNITY_CLASS(Puissance_Complexe, "VA")        // IEEE 1459 - Puissances
+DECLARE_UNITY_CLASS(Tension_RMS, "V", DimTension)                               // IEEE 1459 - Mesures d'énergie
+DECLARE_UNITY_CLASS(THD, "%", DimSansDimension, 0.01f)                          // IEEE 519 - Distorsion harmonique
+DECLARE_UNITY_CLASS(Puissance_Complexe, "VA", DimPuissance)                     // IEEE 1459 - Puissances
 
 // Événements réseau
-DECLARE_UNITY_CLASS(CreteTension, "V")        // Crête de tension (sur/sous-tensions)
-DECLARE_UNITY_CLASS(DureeCrete, "ms")         // Durée de la crête
-DECLARE_UNITY_CLASS(Flicker, "Pst")           // Indice de papillotement (Pst)
-DECLARE_UNITY_CLASS(Interruption, "s")        // Durée d'interruption
+DECLARE_UNITY_CLASS(CreteTension, "V", DimTension)                              // Crête de tension (sur/sous-tensions)
+DECLARE_UNITY_CLASS(DureeCrete, "ms", DimTemps, 1.0e-3f)                        // Durée de la crête
+DECLARE_UNITY_CLASS(Flicker, "Pst", DimSansDimension)                           // Indice de papillotement (Pst)
+DECLARE_UNITY_CLASS(Interruption, "s", DimTemps)                                // Durée d'interruption
 
 // Analyse temporelle
-DECLARE_UNITY_CLASS(DemandeMax, "kW")         // Puissance de demande maximale
-DECLARE_UNITY_CLASS(DureeSousCharge, "%")     // Pourcentage du temps sous-chargé
-DECLARE_UNITY_CLASS(DureeSurCharge, "%")      // Pourcentage du temps surchargé
+DECLARE_UNITY_CLASS(DemandeMax, "kW", DimPuissance, 1.0e3f)                     // Puissance de demande maximale
+DECLARE_UNITY_CLASS(DureeSousCharge, "%", DimSansDimension, 0.01f)              // Pourcentage du temps sous-chargé
+DECLARE_UNITY_CLASS(DureeSurCharge, "%", DimSansDimension, 0.01f)               // Pourcentage du temps surchargé
 
 // Unités en électricité et magnétisme (CGS)
-DECLARE_UNITY_CLASS(ChampMagnetique_Gauss, "G")   // Gauss (1e-4 T)
-DECLARE_UNITY_CLASS(FluxMagnetique_Maxwell, "Mx") // Maxwell (1e-8 Wb)
+DECLARE_UNITY_CLASS(ChampMagnetique_Gauss, "G", DimChampMagnetique, 1.0e-4f)    // Gauss (1e-4 T)
+DECLARE_UNITY_CLASS(FluxMagnetique_Maxwell, "Mx", DimFluxMagnetique, 1.0e-8f)   // Maxwell (1e-8 Wb)
 
 // Unités en radioactivité
-DECLARE_UNITY_CLASS(Radioactivite_Curie, "Ci")    // Curie (3.7e10 Bq)
-DECLARE_UNITY_CLASS(DoseAbsorbee_Rad, "rad")      // Rad (0.01 Gy)
-DECLARE_UNITY_CLASS(DoseEquivalente_Rem, "rem")   // Rem (0.01 Sv)
+DECLARE_UNITY_CLASS(Radioactivite_Curie, "Ci", DimFrequence, 3.7e10f)           // Curie (3.7e10 Bq)
+DECLARE_UNITY_CLASS(DoseAbsorbee_Rad, "rad", DimDoseAbsorbee, 0.01f)            // Rad (0.01 Gy)
+DECLARE_UNITY_CLASS(DoseEquivalente_Rem, "rem", DimDoseAbsorbee, 0.01f)         // Rem (0.01 Sv)
 
 // Grandeurs Mécaniques
-DECLARE_UNITY_CLASS(Force, "N")               // Force (Newton)
-DECLARE_UNITY_CLASS(Longueur, "m")            // Longueur (Mètre)
-DECLARE_UNITY_CLASS(Vitesse, "m/s")           // Vitesse
-DECLARE_UNITY_CLASS(Pression, "Pa")           // Pression (Pascal)
+DECLARE_UNITY_CLASS(Force, "N", DimForce)                                       // Force (Newton)
+DECLARE_UNITY_CLASS(Longueur, "m", DimLongueur)                                 // Longueur (Mètre)
+DECLARE_UNITY_CLASS(Vitesse, "m/s", DimVitesse)                                 // Vitesse
+DECLARE_UNITY_CLASS(Pression, "Pa", DimPression)                                // Pression (Pascal)
 
 // Grandeurs Photométriques
-DECLARE_UNITY_CLASS(FluxLumineux, "lm")       // Flux lumineux (Lumen)
-DECLARE_UNITY_CLASS(Eclairement, "lx")        // Éclairement lumineux (Lux)
-DECLARE_UNITY_CLASS(IntensiteLumineuse, "cd") // Intensité lumineuse (Candela)
-DECLARE_UNITY_CLASS(Eclairement_Footcandle, "fc") // Foot-candle = 10.76 lx
-DECLARE_UNITY_CLASS(Luminance_Nit, "nt")       // Nit = cd/m²
-DECLARE_UNITY_CLASS(Luminance_Stilb, "sb")     // Stilb = 10⁴ cd/m²
+DECLARE_UNITY_CLASS(FluxLumineux, "lm", DimIntensiteLumineuse)                  // Flux lumineux (Lumen)
+DECLARE_UNITY_CLASS(Eclairement, "lx", DimEclairement)                          // Éclairement lumineux (Lux)
+DECLARE_UNITY_CLASS(IntensiteLumineuse, "cd", DimIntensiteLumineuse)            // Intensité lumineuse (Candela)
+DECLARE_UNITY_CLASS(Eclairement_Footcandle, "fc", DimEclairement, 10.763910f)   // Foot-candle = 10.76 lx
+DECLARE_UNITY_CLASS(Luminance_Nit, "nt", DimEclairement)                        // Nit = cd/m²
+DECLARE_UNITY_CLASS(Luminance_Stilb, "sb", DimEclairement, 1.0e4f)              // Stilb = 10⁴ cd/m²
 
 // Grandeurs Temporelles et Fréquentielles
-DECLARE_UNITY_CLASS(Frequence, "Hz")          // Fréquence (Hertz)
-DECLARE_UNITY_CLASS(Temps, "s")               // Temps (Seconde) - également mécanique
+DECLARE_UNITY_CLASS(Frequence, "Hz", DimFrequence)                              // Fréquence (Hertz)
+DECLARE_UNITY_CLASS(Temps, "s", DimTemps)                                       // Temps (Seconde) - également mécanique
 
 // Grandeurs Sans Dimension ou Facteurs
-DECLARE_UNITY_CLASS(Rendement, "ρ")           // Rendement (facteur sans dimension)
-DECLARE_UNITY_CLASS(FacteurQualite, "Q")      // Facteur de qualité (sans dimension)
-DECLARE_UNITY_CLASS(RapportCyclique, "%")     // Rapport cyclique (pourcentage)
+DECLARE_UNITY_CLASS(Rendement, "ρ", DimSansDimension)                           // Rendement (facteur sans dimension)
+DECLARE_UNITY_CLASS(FacteurQualite, "Q", DimSansDimension)                      // Facteur de qualité (sans dimension)
+DECLARE_UNITY_CLASS(RapportCyclique, "%", DimSansDimension, 0.01f)              // Rapport cyclique (pourcentage)
 
 // Grandeurs de Position, Mouvement et Inertie
 // Position et angles
-DECLARE_UNITY_CLASS(PositionLatitude, "°")    // Latitude (degrés décimaux)
-DECLARE_UNITY_CLASS(PositionLongitude, "°")   // Longitude (degrés décimaux)
-DECLARE_UNITY_CLASS(Altitude, "m")            // Altitude (mètres au-dessus du niveau de la mer)
-DECLARE_UNITY_CLASS(Angle_IMU, "°")               // Angle d'inclinaison, roulis, tangage
+DECLARE_UNITY_CLASS(PositionLatitude, "°", DimSansDimension, 0.017453293f)      // Latitude (degrés décimaux)
+DECLARE_UNITY_CLASS(PositionLongitude, "°", DimSansDimension, 0.017453293f)     // Longitude (degrés décimaux)
+DECLARE_UNITY_CLASS(Altitude, "m", DimLongueur)                                 // Altitude (mètres au-dessus du niveau de la mer)
+DECLARE_UNITY_CLASS(Angle_IMU, "°", DimSansDimension, 0.017453293f)             // Angle d'inclinaison, roulis, tangage
 
 // Accélération et vibration
-DECLARE_UNITY_CLASS(Acceleration, "g")        // Accélération (g = 9.80665 m/s²) ou m/s²
-DECLARE_UNITY_CLASS(Vibration, "m/s²")        // Vibration (amplitude d'accélération)
-DECLARE_UNITY_CLASS(FrequenceVibration, "Hz") // Fréquence de vibration
+DECLARE_UNITY_CLASS(Acceleration, "g", DimAcceleration, 9.80665f)               // Accélération (g = 9.80665 m/s²) ou m/s²
+DECLARE_UNITY_CLASS(Vibration, "m/s²", DimAcceleration)                         // Vibration (amplitude d'accélération)
+DECLARE_UNITY_CLASS(FrequenceVibration, "Hz", DimFrequence)                     // Fréquence de vibration
 
 // Vitesse angulaire et champ magnétique terrestre
-DECLARE_UNITY_CLASS(VitesseAngulaire, "°/s")  // Taux de rotation (gyroscope)
-DECLARE_UNITY_CLASS(ChampMagnetiqueTerrestre, "µT") // Magnétomètre (microTesla)
+DECLARE_UNITY_CLASS(VitesseAngulaire, "°/s", DimFrequence, 0.017453293f)        // Taux de rotation (gyroscope)
+DECLARE_UNITY_CLASS(ChampMagnetiqueTerrestre, "µT", DimChampMagnetique, 1.0e-6f) // Magnétomètre (microTesla)
 
 // ----------  Grandeurs Environnementales et Météorologiques ----------
 // Température - Fondamentale pour presque tous les domaines IoT
-DECLARE_UNITY_CLASS(Temperature, "°C")        // Degré Celsius (alternativement "K" pour Kelvin)
-DECLARE_UNITY_CLASS(Humidite, "%RH")          // Humidité relative (Relative Humidity)
-DECLARE_UNITY_CLASS(HumiditeAbsolue, "g/m³")  // Humidité absolue
-DECLARE_UNITY_CLASS(PressionAtmospherique, "hPa") // Pression atmosphérique (hectopascal)
-DECLARE_UNITY_CLASS(Pression_mmHg, "mmHg")        // Millimètre de mercure
-DECLARE_UNITY_CLASS(PointDeRosee, "°C")       // Point de rosée
-DECLARE_UNITY_CLASS(IndiceHumidex, "")        // Indice de chaleur humide (sans unité ou °C)
-DECLARE_UNITY_CLASS(WindChill, "°C")          // Refroidissement éolien
+DECLARE_UNITY_CLASS(Temperature, "°C", DimTemperature)                          // Degré Celsius (alternativement "K" pour Kelvin)
+DECLARE_UNITY_CLASS(Humidite, "%RH", DimSansDimension, 0.01f)                   // Humidité relative (Relative Humidity)
+DECLARE_UNITY_CLASS(HumiditeAbsolue, "g/m³", DimMasseVolumique, 1.0e-3f)        // Humidité absolue
+DECLARE_UNITY_CLASS(PressionAtmospherique, "hPa", DimPression, 100.0f)          // Pression atmosphérique (hectopascal)
+DECLARE_UNITY_CLASS(Pression_mmHg, "mmHg", DimPression, 133.322387f)            // Millimètre de mercure
+DECLARE_UNITY_CLASS(PointDeRosee, "°C", DimTemperature)                         // Point de rosée
+DECLARE_UNITY_CLASS(IndiceHumidex, "", DimSansDimension)                        // Indice de chaleur humide (sans unité ou °C)
+DECLARE_UNITY_CLASS(WindChill, "°C", DimTemperature)                            // Refroidissement éolien
 
 // Vent et précipitations
-DECLARE_UNITY_CLASS(VitesseVent, "m/s")       // Anémomètre (ou km/h)
-DECLARE_UNITY_CLASS(DirectionVent, "°")       // Girouette (degrés de 0 à 360)
-DECLARE_UNITY_CLASS(Pluviometrie, "mm")       // Hauteur de pluie (mm/h, mm/jour)
-DECLARE_UNITY_CLASS(IntensitePluie, "mm/h")   // Intensité des précipitations
+DECLARE_UNITY_CLASS(VitesseVent, "m/s", DimVitesse)                             // Anémomètre (ou km/h)
+DECLARE_UNITY_CLASS(DirectionVent, "°", DimSansDimension, 0.017453293f)         // Girouette (degrés de 0 à 360)
+DECLARE_UNITY_CLASS(Pluviometrie, "mm", DimLongueur, 1.0e-3f)                   // Hauteur de pluie (mm/h, mm/jour)
+DECLARE_UNITY_CLASS(IntensitePluie, "mm/h", DimVitesse, 2.7777778e-7f)          // Intensité des précipitations
 
 // Lumière et rayonnement solaire
-DECLARE_UNITY_CLASS(EclairementSolaire, "W/m²") // Irradiance solaire (différent de Lux)
-DECLARE_UNITY_CLASS(UV_Index, "")             // Indice UV (sans dimension)
-DECLARE_UNITY_CLASS(Luminosite, "lux")        // Déjà présent (Eclairement), mais essentiel pour l'éclairage intelligent
+DECLARE_UNITY_CLASS(EclairementSolaire, "W/m²", DimDensitePuissance)            // Irradiance solaire (différent de Lux)
+DECLARE_UNITY_CLASS(UV_Index, "", DimSansDimension)                             // Indice UV (sans dimension)
+DECLARE_UNITY_CLASS(Luminosite, "lux", DimEclairement)                          // Déjà présent (Eclairement), mais essentiel pour l'éclairage intelligent
 
 // Grandeurs de Qualité de l'Air
-DECLARE_UNITY_CLASS(CO2, "ppm")               // Dioxyde de carbone (Parties par million)
-DECLARE_UNITY_CLASS(COV, "ppb")               // Composés Organiques Volatils (Parties par milliard)
-DECLARE_UNITY_CLASS(CO, "ppm")                // Monoxyde de carbone
-DECLARE_UNITY_CLASS(NO2, "ppb")               // Dioxyde d'azote
-DECLARE_UNITY_CLASS(O3, "ppb")                // Ozone
-DECLARE_UNITY_CLASS(PM1_0, "µg/m³")           // Particules fines < 1.0 µm
-DECLARE_UNITY_CLASS(PM2_5, "µg/m³")           // Particules fines < 2.5 µm
-DECLARE_UNITY_CLASS(PM10, "µg/m³")            // Particules fines < 10 µm
-DECLARE_UNITY_CLASS(IndiceQA, "")             // Indice de Qualité de l'Air (sans dimension, souvent 0-500)
-DECLARE_UNITY_CLASS(Formaldehyde, "ppb")      // Formaldéhyde (HCHO)
+DECLARE_UNITY_CLASS(CO2, "ppm", DimSansDimension, 1.0e-6f)                      // Dioxyde de carbone (Parties par million)
+DECLARE_UNITY_CLASS(COV, "ppb", DimSansDimension, 1.0e-9f)                      // Composés Organiques Volatils (Parties par milliard)
+DECLARE_UNITY_CLASS(CO, "ppm", DimSansDimension, 1.0e-6f)                       // Monoxyde de carbone
+DECLARE_UNITY_CLASS(NO2, "ppb", DimSansDimension, 1.0e-9f)                      // Dioxyde d'azote
+DECLARE_UNITY_CLASS(O3, "ppb", DimSansDimension, 1.0e-9f)                       // Ozone
+DECLARE_UNITY_CLASS(PM1_0, "µg/m³", DimMasseVolumique, 1.0e-9f)                 // Particules fines < 1.0 µm
+DECLARE_UNITY_CLASS(PM2_5, "µg/m³", DimMasseVolumique, 1.0e-9f)                 // Particules fines < 2.5 µm
+DECLARE_UNITY_CLASS(PM10, "µg/m³", DimMasseVolumique, 1.0e-9f)                  // Particules fines < 10 µm
+DECLARE_UNITY_CLASS(IndiceQA, "", DimSansDimension)                             // Indice de Qualité de l'Air (sans dimension, souvent 0-500)
+DECLARE_UNITY_CLASS(Formaldehyde, "ppb", DimSansDimension, 1.0e-9f)             // Formaldéhyde (HCHO)
 
 // Grandeurs pour l'Agriculture et le Sol
-DECLARE_UNITY_CLASS(HumiditeSol, "%")         // Humidité volumique du sol
-DECLARE_UNITY_CLASS(TemperatureSol, "°C")     // Température du sol
-DECLARE_UNITY_CLASS(ConductiviteElectriqueSol, "dS/m") // Conductivité électrique du sol (salinité)
-DECLARE_UNITY_CLASS(pH_Sol, "")               // pH du sol
-DECLARE_UNITY_CLASS(NiveauNutriments, "mg/kg")// Azote, Phosphore, Potassium (N-P-K)
+DECLARE_UNITY_CLASS(HumiditeSol, "%", DimSansDimension, 0.01f)                  // Humidité volumique du sol
+DECLARE_UNITY_CLASS(TemperatureSol, "°C", DimTemperature)                       // Température du sol
+DECLARE_UNITY_CLASS(ConductiviteElectriqueSol, "dS/m", DimConductivite, 0.1f)   // Conductivité électrique du sol (salinité)
+DECLARE_UNITY_CLASS(pH_Sol, "", DimSansDimension)                               // pH du sol
+DECLARE_UNITY_CLASS(NiveauNutriments, "mg/kg", DimSansDimension, 1.0e-6f)       // Azote, Phosphore, Potassium (N-P-K)
+
+// ============================================================================
+// TYPES RÉSULTATS DES PRODUITS ET QUOTIENTS (UNE CLASSE PAR DIMENSION)
+// ============================================================================
+// Ex. Resistance * Courant -> Tension, Tension * Courant -> Puissance
+// (Resistance, Capacite et Inductance sont déclarées plus haut)
+
+DECLARE_UNITY_CANONIQUE(Tension)
+DECLARE_UNITY_CANONIQUE(Courant)
+DECLARE_UNITY_CANONIQUE(Conductance)
+DECLARE_UNITY_CANONIQUE(ChampMagnetique)
+DECLARE_UNITY_CANONIQUE(FluxMagnetique)
+DECLARE_UNITY_CANONIQUE(ChargeElectrique)
+DECLARE_UNITY_CANONIQUE(Conductivite)
+DECLARE_UNITY_CANONIQUE(Resistivite)
+DECLARE_UNITY_CANONIQUE(Energie)
+DECLARE_UNITY_CANONIQUE(Puissance)
+DECLARE_UNITY_CANONIQUE(DensitePuissance)
+DECLARE_UNITY_CANONIQUE(Force)
+DECLARE_UNITY_CANONIQUE(Longueur)
+DECLARE_UNITY_CANONIQUE(Vitesse)
+DECLARE_UNITY_CANONIQUE(Vibration)           // Accélération en m/s²
+DECLARE_UNITY_CANONIQUE(Pression)
+DECLARE_UNITY_CANONIQUE(IntensiteLumineuse)
+DECLARE_UNITY_CANONIQUE(Eclairement)
+DECLARE_UNITY_CANONIQUE(Frequence)
+DECLARE_UNITY_CANONIQUE(Temps)
+
+// ============================================================================
+// RÉPERTOIRE DES UNITÉS (LECTURE DE "4.7kΩ", "100nF", "2.4GHz")
+// ============================================================================
+// Toutes les classes ci-dessus, dans l'ordre de déclaration : l'identifiant
+// d'une classe est sa position (1 = Resistance). Ajouter en fin de liste.
+// Temperature_KC et Angle y figurent par leur unité de stockage (K, rad).
+//
+//   float v; uint8_t id;
+//   if (RepertoireSI::lire("2.4GHz", v, id))          // v = 2.4e9, id = ID_Frequence
+//       Serial.println(RepertoireSI::symbole(id));   // "Hz"
+//   RepertoireSI::facteur(RepertoireSI::ID_EnergieKWh);   // 3.6e6 (vers le joule)
+//   RepertoireSI::dimension(id) == RepertoireSI::dimension(RepertoireSI::ID_Temps)
+//
+// Lorsque la classe attendue est connue : Capacite c; c.lire("100nF");
+
+#define UNITY_REPERTOIRE_SI(X) \
+    X(Resistance) X(Capacite) X(Inductance) X(Tension) X(Courant) X(Conductance) \
+    X(ChampMagnetique) X(FluxMagnetique) X(ChargeElectrique) X(Conductivite) X(Resistivite) \
+    X(Energie) X(Puissance) X(PuissanceApparente) X(PuissanceReactive) X(PuissanceDeformante) \
+    X(EnergieKWh) X(Energie_Calorie) X(Puissance_Cheval) X(Energie_Thermie) X(DensiteEnergie) \
+    X(DensitePuissance) X(CosPhi) X(Lambda) X(TauxHarmonique) X(TensionDC) X(CourantDC) \
+    X(NiveauBatterie) X(Tension_RMS) X(THD) X(Puissance_Complexe) X(CreteTension) X(DureeCrete) \
+    X(Flicker) X(Interruption) X(DemandeMax) X(DureeSousCharge) X(DureeSurCharge) \
+    X(ChampMagnetique_Gauss) X(FluxMagnetique_Maxwell) X(Radioactivite_Curie) \
+    X(DoseAbsorbee_Rad) X(DoseEquivalente_Rem) X(Force) X(Longueur) X(Vitesse) X(Pression) \
+    X(FluxLumineux) X(Eclairement) X(IntensiteLumineuse) X(Eclairement_Footcandle) \
+    X(Luminance_Nit) X(Luminance_Stilb) X(Frequence) X(Temps) X(Rendement) X(FacteurQualite) \
+    X(RapportCyclique) X(PositionLatitude) X(PositionLongitude) X(Altitude) X(Angle_IMU) \
+    X(Acceleration) X(Vibration) X(FrequenceVibration) X(VitesseAngulaire) \
+    X(ChampMagnetiqueTerrestre) X(Temperature) X(Humidite) X(HumiditeAbsolue) \
+    X(PressionAtmospherique) X(Pression_mmHg) X(PointDeRosee) X(IndiceHumidex) X(WindChill) \
+    X(VitesseVent) X(DirectionVent) X(Pluviometrie) X(IntensitePluie) X(EclairementSolaire) \
+    X(UV_Index) X(Luminosite) X(CO2) X(COV) X(CO) X(NO2) X(O3) X(PM1_0) X(PM2_5) X(PM10) \
+    X(IndiceQA) X(Formaldehyde) X(HumiditeSol) X(TemperatureSol) X(ConductiviteElectriqueSol) \
+    X(pH_Sol) X(NiveauNutriments) X(Temperature_KC) X(Angle)
+
+DECLARE_UNITY_REPERTOIRE(RepertoireSI, UNITY_REPERTOIRE_SI)
+
+// ============================================================================
+// QUALITÉ DE L'ÉNERGIE (IEEE 1459, EN UN SEUL PASSAGE)
+// ============================================================================
+
+/**
+ * Grandeurs d'une fenêtre de mesure (nombre entier de périodes du réseau)
+ */
+struct MesuresReseau {
+    Tension_RMS tension;              // U efficace
+    Courant courant;                  // I efficace
+    Puissance active;                 // P
+    PuissanceApparente apparente;     // S = U × I
+    PuissanceReactive reactive;       // Q1, sur le fondamental (> 0 : inductif)
+    PuissanceDeformante deformante;   // D = √(S² - P² - Q1²)
+    CosPhi cosPhi;                    // P1 / S1 : déphasage du fondamental
+    Lambda lambda;                    // P / S : facteur de puissance vrai
+    THD thdTension, thdCourant;       // Distorsion harmonique (%)
+};
+
+/**
+ * Calcul selon le type des échantillons : entiers du CAN (cartes sans FPU),
+ * cosinus en Q14 et sommes exactes sur 64 bits, ou float. VOIES sommes
+ * partielles indépendantes par grandeur laissent le compilateur de l'hôte
+ * vectoriser la boucle (inutile sur AVR, et pour les entiers dont la somme
+ * est associative).
+ */
+template <class E> struct CalculReseau;
+
+template <> struct CalculReseau<int16_t> {
+    typedef int16_t Table;
+    typedef int32_t Produit;
+    typedef int64_t Somme;
+    typedef int64_t Partielle;
+    static const uint8_t VOIES = 1;
+    static float un() { return 16384.0f; }
+    static int16_t coefficient(double c) {  // Arrondi symétrique : Σ cos = 0 sur une période
+        return (int16_t)(c < 0 ? -(int32_t)(-c * 16384.0 + 0.5) : (int32_t)(c * 16384.0 + 0.5));
+    }
+};
+
+template <> struct CalculReseau<float> {
+    typedef float Table;
+    typedef float Produit;
+    typedef double Somme;
+    typedef float Partielle;  // Le temps d'une période au plus
+#ifdef __AVR__
+    static const uint8_t VOIES = 1;
+#else
+    static const uint8_t VOIES = 8;
+#endif
+    static float un() { return 1.0f; }
+    static float coefficient(double c) { return (float)c; }
+};
+
+/**
+ * Analyseur de réseau : consomme des blocs d'échantillons tension/courant
+ * synchrones et entrelacés (u0, i0, u1, i1...), P échantillons par période,
+ * et produit toutes les grandeurs de MesuresReseau à chaque fenêtre de
+ * nbPeriodes périodes (10 à 50 Hz : 200 ms, comme la CEI 61000-4-30).
+ *
+ *   AnalyseurReseau<64> analyseur(gainU, gainI);      // V et A par pas du CAN
+ *   if (analyseur.ajouter(bloc, nbPaires)) {
+ *       const MesuresReseau& m = analyseur.mesures();
+ *       m.active.afficher(Serial);
+ *   }
+ *
+ * Un seul passage sur chaque échantillon : neuf sommes (u, i, u², i², u·i et
+ * projections de u et i sur le fondamental), en mémoire constante. La
+ * composante continue (milieu du CAN) est retirée par les sommes de la
+ * fenêtre : les échantillons bruts conviennent. Le fondamental vient de la
+ * raie de rang 1 de la fenêtre : la fréquence d'échantillonnage doit suivre
+ * celle du réseau (P × 50 Hz).
+ */
+template <uint16_t P, class E = int16_t>
+class AnalyseurReseau {
+    static_assert(P >= 8 && P % 4 == 0, "AnalyseurReseau : P multiple de 4, au moins 8");
+
+    typedef CalculReseau<E> Calcul;
+    typedef typename Calcul::Table Table;
+    typedef typename Calcul::Produit Produit;
+    typedef typename Calcul::Somme Somme;
+    typedef typename Calcul::Partielle Partielle;
+
+public:
+    AnalyseurReseau(float gainTension, float gainCourant, uint16_t nbPeriodes = 10)
+        : gainU(gainTension), gainI(gainCourant), periodes(nbPeriodes ? nbPeriodes : 1) {
+        // cos sur une période et un quart : le sinus est lu P/4 plus loin
+        for (uint16_t k = 0; k < P + P / 4; k++) cosinus[k] = Calcul::coefficient(cos(2.0 * C_UNITY::PI_ * k / P));
+        effacer();
+    }
+
+    void effacer() {
+        sommes = Sommes();
+        phase = 0;
+        restants = (uint32_t)P * periodes;
+        nouvelles = false;
+    }
+
+    /**
+     * Ajoute nbPaires paires (u, i) ; renvoie le nombre de fenêtres
+     * terminées dans ce bloc (mesures() : la dernière)
+     */
+    uint16_t ajouter(const E* bloc, size_t nbPaires) {
+        uint16_t fenetres = 0;
+        while (nbPaires > 0) {
+            // Tranche sans retour au début de la table ni fin de fenêtre
+            uint16_t n = (uint16_t)(P - phase);
+            if (n > restants) n = (uint16_t)restants;
+            if (n > nbPaires) n = (uint16_t)nbPaires;
+            cumuler(bloc, cosinus + phase, cosinus + phase + P / 4, n, sommes);
+            bloc += 2 * n;
+            nbPaires -= n;
+            phase = (uint16_t)((phase + n) % P);
+            restants -= n;
+            if (restants == 0) {
+                terminer();
+                sommes = Sommes();
+                restants = (uint32_t)P * periodes;
+                fenetres++;
+            }
+        }
+        return fenetres;
+    }
+
+    const MesuresReseau& mesures() const { return derniere; }
+
+    // Vrai une fois par fenêtre terminée, jusqu'à la lecture suivante
+    bool nouvelleMesure() {
+        bool n = nouvelles;
+        nouvelles = false;
+        return n;
+    }
+
+private:
+    struct Sommes {
+        Somme u, i, uu, ii, ui;
+        Somme uc, us, ic, is;  // Projections sur cos et -sin du fondamental
+
+        Sommes() : u(0), i(0), uu(0), ii(0), ui(0), uc(0), us(0), ic(0), is(0) {}
+    };
+
+    float gainU, gainI;
+    uint16_t periodes;
+    uint16_t phase;      // Rang de l'échantillon suivant dans la période
+    uint32_t restants;   // Échantillons avant la fin de la fenêtre
+    bool nouvelles;
+    Sommes sommes;
+    MesuresReseau derniere;
+    Table cosinus[P + P / 4];
+
+    /**
+     * Le seul passage sur les échantillons : n ≤ P paires, cos et -sin du
+     * fondamental lus dans la table à partir de c et s
+     */
+    static void cumuler(const E* ech, const Table* c, const Table* s, uint16_t n, Sommes& total) {
+        const uint8_t V = Calcul::VOIES;
+        Partielle u[V], i[V], uu[V], ii[V], ui[V], uc[V], us[V], ic[V], is[V];
+        for (uint8_t v = 0; v < V; v++) u[v] = i[v] = uu[v] = ii[v] = ui[v] = uc[v] = us[v] = ic[v] = is[v] = 0;
+        uint16_t j = 0;
+        for (; j + V <= n; j += V) {
+            for (uint8_t v = 0; v < V; v++) {
+                Produit x = ech[2 * (j + v)], y = ech[2 * (j + v) + 1];
+                u[v] += x;
+                i[v] += y;
+                uu[v] += x * x;
+                ii[v] += y * y;
+                ui[v] += x * y;
+                uc[v] += x * c[j + v];
+                us[v] += x * s[j + v];
+                ic[v] += y * c[j + v];
+                is[v] += y * s[j + v];
+            }
+        }
+        for (; j < n; j++) {
+            Produit x = ech[2 * j], y = ech[2 * j + 1];
+            u[0] += x;
+            i[0] += y;
+            uu[0] += x * x;
+            ii[0] += y * y;
+            ui[0] += x * y;
+            uc[0] += x * c[j];
+            us[0] += x * s[j];
+            ic[0] += y * c[j];
+            is[0] += y * s[j];
+        }
+        for (uint8_t v = 0; v < V; v++) {
+            total.u += u[v];
+            total.i += i[v];
+            total.uu += uu[v];
+            total.ii += ii[v];
+            total.ui += ui[v];
+            total.uc += uc[v];
+            total.us += us[v];
+            total.ic += ic[v];
+            total.is += is[v];
+        }
+    }
+
+    // Fin de fenêtre : les grandeurs à partir des sommes (une fois par fenêtre)
+    void terminer() {
+        const Somme n = (Somme)P * periodes;
+        const double n2 = (double)n * (double)n;
+        // Variances et covariance : (n Σxy - Σx Σy) / n², exact en entier
+        double u2 = (double)(n * sommes.uu - sommes.u * sommes.u) / n2;
+        double i2 = (double)(n * sommes.ii - sommes.i * sommes.i) / n2;
+        double ui = (double)(n * sommes.ui - sommes.u * sommes.i) / n2;
+        // Fondamental : valeurs efficaces² = 2 |X|² / n² (cos en Q14 pour les entiers)
+        const double k = 2.0 / (n2 * (double)Calcul::un() * (double)Calcul::un());
+        double uc = (double)sommes.uc, us = (double)sommes.us, ic = (double)sommes.ic, is = (double)sommes.is;
+        double u1 = sqrt((uc * uc + us * us) * k), i1 = sqrt((ic * ic + is * is) * k);
+        double p1 = (uc * ic + us * is) * k, q1 = (us * ic - uc * is) * k;
+
+        const double gp = (double)gainU * gainI;
+        double u = sqrt(u2 > 0 ? u2 : 0) * gainU, i = sqrt(i2 > 0 ? i2 : 0) * gainI;
+        double p = ui * gp, s = u * i, q = q1 * gp;
+        double d = s * s - p * p - q * q;
+        double s1 = u1 * i1;
+
+        derniere.tension = (float)u;
+        derniere.courant = (float)i;
+        derniere.active = (float)p;
+        derniere.apparente = (float)s;
+        derniere.reactive = (float)q;
+        derniere.deformante = (float)sqrt(d > 0 ? d : 0);
+        derniere.cosPhi = (float)(s1 > 0 ? p1 / s1 : 0);
+        derniere.lambda = (float)(s > 0 ? p / s : 0);
+        derniere.thdTension = (float)(u1 > 0 ? 100.0 * sqrt(u2 > u1 * u1 ? u2 / (u1 * u1) - 1.0 : 0) : 0);
+        derniere.thdCourant = (float)(i1 > 0 ? 100.0 * sqrt(i2 > i1 * i1 ? i2 / (i1 * i1) - 1.0 : 0) : 0);
+        nouvelles = true;
+    }
+};
 
 // ============================================================================
 // ALIAS POUR UNE UTILISATION SIMPLIFIÉE
@@ -9,249 +9,4016 @@
 #define C_UNITY_H
 
 #include <Arduino.h>
+#include <float.h>
 #include <math.h>
+#include <string.h>
+
+// Accès à la mémoire flash : lecture directe sur les plateformes sans PROGMEM
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(adr) (*(const uint8_t*)(adr))
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(adr) (*(const uint16_t*)(adr))
+#endif
+#ifndef pgm_read_dword
+#define pgm_read_dword(adr) (*(const uint32_t*)(adr))
+#endif
+#ifndef pgm_read_float
+#define pgm_read_float(adr) (*(const float*)(adr))
+#endif
 
 // ============================================================================
-// CLASSE C_UNITY GÉNÉRIQUE
+// INSTRUMENTATION DES POINTS D'ENTRÉE (OPTIONNELLE)
 // ============================================================================
 
-class C_UNITY {
-protected:
-    float valeur;  // Valeur stockée pour les méthodes d'instance
+/**
+ * #define UNITY_INSTRUMENTATION avant #include "Unity.h" : chaque appel de
+ * formatage est compté et chronométré, et les octets demandés au tas par
+ * les versions String sont totalisés, par point d'entrée :
+ *
+ *   InstrumentationUnity::rapport(Serial);           // Tableau complet
+ *   InstrumentationUnity::lire(InstrumentationUnity::FORMAT_NOMBRE).maximum;
+ *   InstrumentationUnity::effacer();
+ *
+ * Durées lues par UNITY_HORLOGE(), micros() par défaut ; un compteur de
+ * cycles le remplace si on le définit avant l'inclusion (ex. ESP32 :
+ * #define UNITY_HORLOGE() ESP.getCycleCount()). Les durées sont inclusives :
+ * afficher() compte aussi dans valeurAvecUnite() qu'il appelle.
+ * Sans UNITY_INSTRUMENTATION, UNITY_CHRONO et UNITY_ALLOCATION ne produisent
+ * aucun code et InstrumentationUnity n'existe pas (pas de RAM ni de flash).
+ */
+#ifdef UNITY_INSTRUMENTATION
+
+#ifndef UNITY_HORLOGE
+#define UNITY_HORLOGE() micros()
+#endif
 
+// Cumul d'un point d'entrée (durées en unités de UNITY_HORLOGE)
+struct StatistiquesUnity {
+    uint32_t appels;
+    uint32_t total;
+    uint32_t maximum;
+    uint32_t allocations;  // Demandes au tas (String du résultat, copies)
+    uint32_t octets;
+};
+
+class InstrumentationUnity {
 public:
-    // Constructeurs
-    C_UNITY() : valeur(0.0) {}
-    C_UNITY(float val) : valeur(val) {}
-    
-    // Méthodes d'accès
-    float getValeur() const { return valeur; }
-    void setValeur(float val) { valeur = val; }
+    enum Point {
+        VALEUR_AVEC_UNITE,      // valeurAvecUnite -> String
+        VALEUR_TAMPON,          // valeurAvecUnite(char*, ...)
+        VALEUR_SORTIE,          // valeurAvecUnite(Print&, ...)
+        VALEURS_LOT,            // valeursAvecUnite (tampon et sortie)
+        FORMAT_NOMBRE,          // formatNombre -> String
+        FORMAT_NOMBRE_TAMPON,   // formatNombre(char*, ...)
+        AFFICHER,               // afficher() des grandeurs typées
+        NB_POINTS
+    };
+
+    static const StatistiquesUnity& lire(Point p) { return table()[p]; }
 
-    // Opérateurs arithmétiques simplifiés (retournent C_UNITY)
-    C_UNITY operator+(const C_UNITY& other) const {
-        return C_UNITY(valeur + other.valeur);
+    static void effacer() { memset(table(), 0, sizeof(StatistiquesUnity) * NB_POINTS); }
+
+    static const char* nom(Point p) {  // En flash sur AVR
+        static const char noms[NB_POINTS][20] PROGMEM = {
+            "valeurAvecUnite", "valeurAvecUnite[]", "valeurAvecUnite>>", "valeursAvecUnite",
+            "formatNombre", "formatNombre[]", "afficher",
+        };
+        return noms[p];
     }
 
-    C_UNITY operator-(const C_UNITY& other) const {
-        return C_UNITY(valeur - other.valeur);
+    /**
+     * Une ligne par point d'entrée appelé : appels, durée totale, moyenne
+     * et maximale, allocations et octets demandés au tas
+     */
+    static void rapport(Print& sortie) {
+        sortie.println(F("point                 appels      total    moyenne        max  allocs     octets"));
+        for (int p = 0; p < NB_POINTS; p++) {
+            const StatistiquesUnity& s = table()[p];
+            if (!s.appels) continue;
+            const char* libelle = nom((Point)p);
+            size_t n = 0;
+            while (pgm_read_byte(libelle + n) != '\0') n++;
+            sortie.print(reinterpret_cast<const __FlashStringHelper*>(libelle));
+            while (n++ < 19) sortie.write(' ');
+            colonne(sortie, s.appels, 8);
+            colonne(sortie, s.total, 11);
+            colonne(sortie, s.total / s.appels, 11);
+            colonne(sortie, s.maximum, 11);
+            colonne(sortie, s.allocations, 8);
+            colonne(sortie, s.octets, 11);
+            sortie.println();
+        }
     }
-    
-    C_UNITY operator*(const C_UNITY& other) const {
-        return C_UNITY(valeur * other.valeur);
+
+    static void compter(Point p, uint32_t duree) {
+        StatistiquesUnity& s = table()[p];
+        s.appels++;
+        s.total += duree;
+        if (duree > s.maximum) s.maximum = duree;
     }
 
-    C_UNITY operator/(const C_UNITY& other) const {
-        if (other.valeur != 0.0) return C_UNITY(valeur / other.valeur); // Évite la division par zéro
-        else return NAN;
+    static void allouer(Point p, size_t octets) {
+        table()[p].allocations++;
+        table()[p].octets += (uint32_t)octets;
     }
-    
-    // Opérateurs avec des floats
-    C_UNITY operator+(float val) const {
-        return C_UNITY(valeur + val);
+
+private:
+    static StatistiquesUnity* table() {
+        static StatistiquesUnity cumuls[NB_POINTS];
+        return cumuls;
     }
 
-    C_UNITY operator-(float val) const {
-        return C_UNITY(valeur - val);
+    // Entier aligné à droite sur largeur caractères
+    static void colonne(Print& sortie, uint32_t v, int largeur) {
+        char chiffres[10];
+        int n = 0;
+        do {
+            chiffres[n++] = '0' + (char)(v % 10);
+            v /= 10;
+        } while (v);
+        while (largeur-- > n) sortie.write(' ');
+        while (n) sortie.write(chiffres[--n]);
     }
-    
-    C_UNITY operator*(float val) const {
-        return C_UNITY(valeur * val);
+};
+
+// Chronomètre d'une portée : la durée est ajoutée à la sortie de la fonction
+class ChronoUnity {
+public:
+    explicit ChronoUnity(InstrumentationUnity::Point p) : point(p), debut((uint32_t)UNITY_HORLOGE()) {}
+    ~ChronoUnity() { InstrumentationUnity::compter(point, (uint32_t)UNITY_HORLOGE() - debut); }
+
+private:
+    InstrumentationUnity::Point point;
+    uint32_t debut;
+};
+
+#define UNITY_CHRONO(point) ChronoUnity chronoUnity(InstrumentationUnity::point)
+#define UNITY_ALLOCATION(point, octets) InstrumentationUnity::allouer(InstrumentationUnity::point, octets)
+#else
+#define UNITY_CHRONO(point)
+#define UNITY_ALLOCATION(point, octets)
+#endif
+
+// ============================================================================
+// REPRÉSENTATIONS DE LA VALEUR (FLOAT, DOUBLE, VIRGULE FIXE)
+// ============================================================================
+
+/**
+ * Nombre signé en virgule fixe sur 32 bits, dont F bits de fraction.
+ * Pour les cartes sans FPU : addition et comparaison sont des opérations
+ * entières, produit et quotient passent par 64 bits. Plage ±2^(31-F),
+ * pas 2^-F (VirguleFixe<16> : ±32768 au pas de 1.5e-5).
+ * Les conversions depuis float/double sont constexpr : une constante comme
+ * VirguleFixe<16>(3.3) ne coûte rien à l'exécution.
+ */
+template <int F>
+class VirguleFixe {
+    static_assert(F > 0 && F < 31, "VirguleFixe : 1 a 30 bits de fraction");
+
+    struct Brut {};
+    constexpr VirguleFixe(int32_t b, Brut) : brut(b) {}
+
+    static constexpr int32_t arrondir(double x) {
+        return (int32_t)(x < 0 ? x - 0.5 : x + 0.5);
     }
 
-    C_UNITY operator/(float val) const {
-        if (val != 0.0) return C_UNITY(valeur / val); // Évite la division par zéro
-        else return NAN;
+public:
+    static constexpr int32_t UN = (int32_t)1 << F;
+    static constexpr int32_t BRUT_INVALIDE = -2147483647L - 1; // Division par zéro (nan)
+
+    int32_t brut;  // Valeur × 2^F
+
+    constexpr VirguleFixe() : brut(0) {}
+    constexpr VirguleFixe(int v) : brut((int32_t)v * UN) {}
+    constexpr VirguleFixe(long v) : brut((int32_t)v * UN) {}
+    constexpr VirguleFixe(float v) : brut(arrondir((double)v * UN)) {}
+    constexpr VirguleFixe(double v) : brut(arrondir(v * UN)) {}
+
+    static constexpr VirguleFixe depuisBrut(int32_t b) { return VirguleFixe(b, Brut()); }
+    static constexpr VirguleFixe invalide() { return VirguleFixe(BRUT_INVALIDE, Brut()); }
+
+    constexpr float versFloat() const { return (float)brut / (float)UN; }
+    constexpr double versDouble() const { return (double)brut / (double)UN; }
+    explicit operator float() const { return versFloat(); }
+    explicit operator double() const { return versDouble(); }
+
+    // Opérateurs (amis : un float ou un entier est converti des deux côtés)
+    friend VirguleFixe operator+(VirguleFixe a, VirguleFixe b) { return depuisBrut(a.brut + b.brut); }
+    friend VirguleFixe operator-(VirguleFixe a, VirguleFixe b) { return depuisBrut(a.brut - b.brut); }
+
+    friend VirguleFixe operator*(VirguleFixe a, VirguleFixe b) {
+        return depuisBrut((int32_t)(((int64_t)a.brut * b.brut + (UN >> 1)) >> F));
     }
-    
-    // Opérateurs de conversion vers float (simplifie les calculs)
-    operator float() const {
-        return valeur;
+
+    friend VirguleFixe operator/(VirguleFixe a, VirguleFixe b) {
+        if (b.brut == 0) return invalide();
+        return depuisBrut((int32_t)((int64_t)a.brut * UN / b.brut));
     }
-    
-    // Opérateurs de comparaison
-    bool operator==(const C_UNITY& other) const {
-        return valeur == other.valeur;
+
+    VirguleFixe operator-() const { return depuisBrut(-brut); }
+
+    VirguleFixe& operator+=(VirguleFixe b) { return *this = *this + b; }
+    VirguleFixe& operator-=(VirguleFixe b) { return *this = *this - b; }
+    VirguleFixe& operator*=(VirguleFixe b) { return *this = *this * b; }
+    VirguleFixe& operator/=(VirguleFixe b) { return *this = *this / b; }
+
+    friend bool operator==(VirguleFixe a, VirguleFixe b) { return a.brut == b.brut; }
+    friend bool operator!=(VirguleFixe a, VirguleFixe b) { return a.brut != b.brut; }
+    friend bool operator<(VirguleFixe a, VirguleFixe b) { return a.brut < b.brut; }
+    friend bool operator>(VirguleFixe a, VirguleFixe b) { return a.brut > b.brut; }
+    friend bool operator<=(VirguleFixe a, VirguleFixe b) { return a.brut <= b.brut; }
+    friend bool operator>=(VirguleFixe a, VirguleFixe b) { return a.brut >= b.brut; }
+};
+
+template <int F> constexpr int32_t VirguleFixe<F>::UN;
+template <int F> constexpr int32_t VirguleFixe<F>::BRUT_INVALIDE;
+
+/**
+ * Propriétés de chaque représentation :
+ * Constante : type des constantes physiques (double garde sa précision,
+ *             la virgule fixe les garde en float : elles sortent de sa plage)
+ * etendu    : vrai pour double et virgule fixe, dont les surcharges sont des
+ *             gabarits pour ne pas rendre ambigus les appels avec un entier
+ */
+template <class T> struct ScalaireUnity { static constexpr bool etendu = false; };
+
+template <> struct ScalaireUnity<float> {
+    typedef float Constante;
+    static constexpr bool etendu = false;
+    static float invalide() { return NAN; }
+    static bool estValide(float v) { return v == v; }
+    static double versDouble(float v) { return v; }
+};
+
+template <> struct ScalaireUnity<double> {
+    typedef double Constante;
+    static constexpr bool etendu = true;
+    static double invalide() { return NAN; }
+    static bool estValide(double v) { return v == v; }
+    static double versDouble(double v) { return v; }
+};
+
+template <int F> struct ScalaireUnity<VirguleFixe<F> > {
+    typedef float Constante;
+    static constexpr bool etendu = true;
+    static VirguleFixe<F> invalide() { return VirguleFixe<F>::invalide(); }
+    static bool estValide(VirguleFixe<F> v) { return v.brut != VirguleFixe<F>::BRUT_INVALIDE; }
+    static double versDouble(VirguleFixe<F> v) { return v.versDouble(); }
+};
+
+// Types arithmétiques acceptés comme scalaires (sans <type_traits>, absent sur AVR)
+template <class S> struct EstScalaire { static constexpr bool valeur = false; };
+template <> struct EstScalaire<char> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<signed char> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<unsigned char> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<short> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<unsigned short> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<int> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<unsigned int> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<long> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<unsigned long> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<long long> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<unsigned long long> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<float> { static constexpr bool valeur = true; };
+template <> struct EstScalaire<double> { static constexpr bool valeur = true; };
+template <int F> struct EstScalaire<VirguleFixe<F> > { static constexpr bool valeur = true; };
+
+template <bool Condition, class T = void> struct ActiverSi {};
+template <class T> struct ActiverSi<true, T> { typedef T type; };
+
+template <class A, class B> struct MemeType { static constexpr bool valeur = false; };
+template <class A> struct MemeType<A, A> { static constexpr bool valeur = true; };
+
+// ============================================================================
+// FORMATAGE COMMUN À TOUTES LES REPRÉSENTATIONS
+// ============================================================================
+
+/**
+ * Fonctions statiques de formatage (préfixes SI, tampon, lots, milliers) :
+ * indépendantes du type de la valeur stockée, elles ne sont compilées qu'une
+ * fois pour toutes les instanciations de C_UNITY_T
+ */
+class C_UNITY_BASE {
+public:
+    /**
+     * Convertit une valeur avec l'unité appropriée en utilisant les préfixes SI
+     * (Version statique)
+     */
+    static String valeurAvecUnite(float val, String unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        UNITY_ALLOCATION(VALEUR_AVEC_UNITE, unite.length() + 1);  // Copie du symbole (passé par valeur)
+        return chaineAvecUnite(val, unite, unite.length(), nbDecimal, espaceAvantUnite);
     }
     
-    bool operator!=(const C_UNITY& other) const {
-        return valeur != other.valeur;
+    /**
+     * Idem avec un symbole en flash (F("...") ou symbole() d'une classe d'unité) :
+     * le symbole est lu sur place, une seule allocation pour le résultat
+     */
+    static String valeurAvecUnite(float val, const __FlashStringHelper* unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return chaineAvecUnite(val, unite, longueurP(unite), nbDecimal, espaceAvantUnite);
     }
-    
-    bool operator<(const C_UNITY& other) const {
-        return valeur < other.valeur;
+
+    /**
+     * Versions double et virgule fixe (voir ScalaireUnity::etendu : un appel
+     * avec un entier reste sur la version float, sans ambiguïté)
+     */
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, String>::type
+    valeurAvecUnite(R val, String unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        UNITY_ALLOCATION(VALEUR_AVEC_UNITE, unite.length() + 1);
+        return chaineAvecUnite(val, unite, unite.length(), nbDecimal, espaceAvantUnite);
     }
-    
-    bool operator>(const C_UNITY& other) const {
-        return valeur > other.valeur;
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, String>::type
+    valeurAvecUnite(R val, const __FlashStringHelper* unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return chaineAvecUnite(val, unite, longueurP(unite), nbDecimal, espaceAvantUnite);
     }
-    
-    bool operator<=(const C_UNITY& other) const {
-        return valeur <= other.valeur;
+
+    // Nombre formaté sur la pile, puis une seule allocation pour le résultat.
+    // Un nombre plus long que la pile (au-delà du plus grand préfixe, nombreuses
+    // décimales) est écrit dans un tampon du tas de la taille maximale
+    template <class R, class Unite>
+    static String chaineAvecUnite(R val, const Unite& unite, size_t longueurUnite, int nbDecimal, bool espaceAvantUnite) {
+        UNITY_CHRONO(VALEUR_AVEC_UNITE);
+        char pile[TAILLE_NOMBRE];
+        Tampon t(pile, sizeof(pile));
+        ecrireValeur(t, val, nbDecimal, espaceAvantUnite);
+        String result;  // Un seul objet retourné (NRVO), même en cas d'échec
+        char* tas = nullptr;
+        if (t.plein()) {
+            size_t cap = DBL_MAX_10_EXP + (nbDecimal > 0 ? (size_t)nbDecimal : 0) + 16;
+            UNITY_ALLOCATION(VALEUR_AVEC_UNITE, cap);  // Tampon provisoire
+            tas = (char*)malloc(cap);
+            if (!tas) return result;
+            t = Tampon(tas, cap);
+            ecrireValeur(t, val, nbDecimal, espaceAvantUnite);
+        }
+        largeurDtostrf(t, nbDecimal);
+        t.terminer();
+
+        UNITY_ALLOCATION(VALEUR_AVEC_UNITE, 1);  // String vide : 1 octet (WString)
+        UNITY_ALLOCATION(VALEUR_AVEC_UNITE, t.len + longueurUnite + 1);
+        result.reserve(t.len + longueurUnite);
+        result += t.out;
+        result += unite;
+        free(tas);
+        return result;
     }
     
-    bool operator>=(const C_UNITY& other) const {
-        return valeur >= other.valeur;
+    // ------------------------------------------------------------------------
+    // FORMATAGE SANS ALLOCATION (TAMPON FOURNI PAR L'APPELANT)
+    // ------------------------------------------------------------------------
+
+    /**
+     * Longueur d'une chaîne en flash (sans dépendre de strlen_P, absent de certains cœurs)
+     */
+    static size_t longueurP(const __FlashStringHelper* s) {
+        const char* p = reinterpret_cast<const char*>(s);
+        size_t n = 0;
+        while (pgm_read_byte(p + n) != '\0') n++;
+        return n;
     }
-    
+
+    // Taille suffisante pour espace, signe, nombre et préfixe jusqu'à ~30 décimales
+    static constexpr size_t TAILLE_NOMBRE = 48;
+
     /**
-     * Convertit une valeur avec l'unité appropriée en utilisant les préfixes SI
-     * (Version statique)
+     * Tampon d'écriture borné : tronque au lieu de déborder.
+     * len reste toujours < cap, ce qui laisse la place du '\0' final.
+     * Avec une sortie (Print), le tampon plein est vidé dans la sortie au lieu
+     * de tronquer : mêmes fonctions d'écriture, sans limite de longueur
      */
-    static String valeurAvecUnite(float val, String unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
-        String result;
-        if (espaceAvantUnite) result = " ";
-        else result = "";
-        
-        // Gestion des valeurs négatives
-        bool isNegative = val < 0;
-        if (isNegative) {
-            result += "-";
+    struct Tampon {
+        char* out;
+        size_t cap;
+        size_t len;
+        Print* sortie;
+        size_t envoyes;  // Octets déjà passés à la sortie
+
+        Tampon(char* o, size_t c) : out(o), cap(c), len(0), sortie(nullptr), envoyes(0) {}
+        Tampon(char* o, size_t c, Print& s) : out(o), cap(c), len(0), sortie(&s), envoyes(0) {}
+
+        void ajouter(char c) {
+            if (len + 1 < cap) out[len++] = c;
+            else if (sortie) { vider(); out[len++] = c; }
+        }
+
+        // Tampon plein sans sortie : la suite serait tronquée
+        bool plein() const {
+            return !sortie && len + 1 >= cap;
+        }
+
+        void vider() {
+            envoyes += sortie->write(reinterpret_cast<const uint8_t*>(out), len);
+            len = 0;
+        }
+
+        void ajouter(const char* s) {
+            while (*s) ajouter(*s++);
+        }
+
+        void ajouterP(const char* s) {  // Chaîne en flash (PROGMEM)
+            for (char c; (c = (char)pgm_read_byte(s)) != '\0'; s++) ajouter(c);
+        }
+
+        void ajouter(const __FlashStringHelper* s) {
+            ajouterP(reinterpret_cast<const char*>(s));
+        }
+
+        // Termine la chaîne, ou vide le reste dans la sortie (total envoyé)
+        size_t terminer() {
+            if (sortie) {
+                vider();
+                return envoyes;
+            }
+            if (cap) out[len] = '\0';
+            return len;
+        }
+    };
+
+    /**
+     * Largeur minimale de String(float, nbDecimal) (dtostrf, nbDecimal + 2),
+     * comme dans la version String d'origine : une mantisse d'un seul
+     * chiffre sans décimale ("R1 =   1kΩ") ou "inf" sont précédés d'espaces,
+     * après le signe. "0.0" et "ε", écrits tels quels en 1.0.0, ne le sont
+     * pas. Les versions tampon et Print n'ajoutent pas ces espaces.
+     */
+    static void largeurDtostrf(Tampon& t, int nbDecimal) {
+        size_t d = 0;
+        if (d < t.len && t.out[d] == ' ') d++;
+        if (d < t.len && t.out[d] == '-') d++;
+        size_t champ = d;
+        if (t.len - d >= 3 && memcmp(t.out + d, "inf", 3) == 0) champ += 3;
+        while (champ < t.len && ((t.out[champ] >= '0' && t.out[champ] <= '9') || t.out[champ] == '.')) champ++;
+        champ -= d;
+        if (champ == 0 || (champ == 3 && memcmp(t.out + d, "0.0", 3) == 0)) return;
+        size_t largeur = (size_t)(nbDecimal + 2);
+        if (nbDecimal < 0 || champ >= largeur || t.len + largeur - champ >= t.cap) return;
+        size_t ajout = largeur - champ;
+        memmove(t.out + d + ajout, t.out + d, t.len - d);
+        memset(t.out + d, ' ', ajout);
+        t.len += ajout;
+    }
+
+    /**
+     * Entrée de la table des préfixes SI (stockée en flash sur AVR)
+     */
+    struct PrefixeSI {
+        char symbole[3];   // UTF-8, "µ" occupe 2 octets
+        float facteur;     // Ramène la valeur dans [1, 1000[
+        uint32_t seuil;    // Motif binaire du plus petit float >= 10^(3g)
+    };
+
+    // Indices dans la table : 0 = quecto (1e-30) ... 10 = unité ... 20 = quetta (1e30)
+    static constexpr int INDICE_UNITE = 10;
+#ifdef UNITY_PREFIXES_ETENDUS
+    static constexpr int INDICE_MIN = 0;   // quecto
+    static constexpr int INDICE_MAX = 20;  // quetta
+#else
+    static constexpr int INDICE_MIN = 4;   // atto
+    static constexpr int INDICE_MAX = 14;  // téra
+#endif
+
+    static const PrefixeSI* tablePrefixes() {
+        // Les flottants positifs se comparent comme des entiers : les seuils
+        // sont gardés sous forme de motifs binaires pour éviter toute
+        // comparaison flottante (logicielle sur AVR)
+        static constexpr PrefixeSI table[] PROGMEM = {
+            { "q", 1.0e30f,  0x0DA24260UL },
+            { "r", 1.0e27f,  0x129E74D2UL },
+            { "y", 1.0e24f,  0x179ABE15UL },
+            { "z", 1.0e21f,  0x1C971DA1UL },
+            { "a", 1.0e18f,  0x219392EFUL },
+            { "f", 1.0e15f,  0x26901D7DUL },
+            { "p", 1.0e12f,  0x2B8CBCCDUL },
+            { "n", 1.0e9f,   0x30897060UL },
+            { "µ", 1.0e6f,   0x358637BEUL },
+            { "m", 1.0e3f,   0x3A83126FUL },
+            { "",  1.0f,     0x3F800000UL },
+            { "k", 1.0e-3f,  0x447A0000UL },
+            { "M", 1.0e-6f,  0x49742400UL },
+            { "G", 1.0e-9f,  0x4E6E6B28UL },
+            { "T", 1.0e-12f, 0x5368D4A6UL },
+            { "P", 1.0e-15f, 0x58635FAAUL },
+            { "E", 1.0e-18f, 0x5D5E0B6CUL },
+            { "Z", 1.0e-21f, 0x6258D727UL },
+            { "Y", 1.0e-24f, 0x6753C21CUL },
+            { "R", 1.0e-27f, 0x6C4ECB90UL },
+            { "Q", 1.0e-30f, 0x7149F2CAUL },
+        };
+        return table;
+    }
+
+    /**
+     * Indice du préfixe SI d'une valeur strictement positive, ou -1 si elle
+     * est trop petite (ε). Coût constant : l'exposant binaire du float donne
+     * le groupe de 10^3 à un près, une comparaison entière tranche le reste.
+     */
+    static int indicePrefixe(float val) {
+        uint32_t bits;
+        memcpy(&bits, &val, sizeof(bits));
+        return indicePrefixeBits(bits);
+    }
+
+    // Idem à partir du motif binaire du float (positif)
+    static int indicePrefixeBits(uint32_t bits) {
+        // floor(log10(2^e) / 3) + 13 pour l'exposant biaisé E, en entiers 16 bits
+        uint16_t exposant = (uint16_t)(bits >> 23);
+        int indice = (int)((uint16_t)(exposant * 103u + 231u) >> 10) - 3;
+
+        if (indice >= INDICE_MAX) return INDICE_MAX;
+        if (indice < INDICE_MIN - 1) return -1;
+        if (bits >= pgm_read_dword(&tablePrefixes()[indice + 1].seuil)) indice++;
+        return indice >= INDICE_MIN ? indice : -1;
+    }
+
+    /**
+     * Version double : classement sur le float le plus proche, corrigé si
+     * l'arrondi en float a fait franchir un seuil
+     */
+    static int indicePrefixe(double val) {
+        if (val < 1.0e-36) return -1;          // Sous tous les préfixes
+        if (val > 1.0e36) return INDICE_MAX;   // Au-delà des float
+        int indice = indicePrefixe((float)val);
+        if (indice >= INDICE_MIN && echelle(val, indice) < 1.0) indice = indice > INDICE_MIN ? indice - 1 : -1;
+        return indice;
+    }
+
+    /**
+     * Motif binaire (tronqué) du float valant mantisse × 2^exposant, calculé
+     * en entiers : la virgule fixe choisit son préfixe sans calcul flottant.
+     * La troncature ne peut que sous-estimer le préfixe, ce que corrige la
+     * retenue d'arrondi à l'écriture
+     */
+    static uint32_t bitsFlottant(uint32_t mantisse, int exposant) {
+        if (mantisse == 0) return 0;
+        while (mantisse >= 0x01000000UL) { mantisse >>= 1; exposant++; }
+        while (mantisse < 0x00008000UL) { mantisse <<= 8; exposant -= 8; }
+        while (mantisse < 0x00800000UL) { mantisse <<= 1; exposant--; }
+        int biaise = exposant + 150;
+        if (biaise <= 0) return 0;               // Sous les float normalisés (ε)
+        if (biaise >= 0xFF) return 0x7F7FFFFFUL; // Plus grand float
+        return ((uint32_t)biaise << 23) | (mantisse & 0x7FFFFFUL);
+    }
+
+    // Indice du préfixe de |val| pour chaque représentation
+    static int indiceValeur(float val) { return indicePrefixe(fabsf(val)); }
+    static int indiceValeur(double val) { return indicePrefixe(fabs(val)); }
+
+    template <int F>
+    static int indiceValeur(VirguleFixe<F> val) {
+        uint32_t module = val.brut < 0 ? 0u - (uint32_t)val.brut : (uint32_t)val.brut;
+        return indicePrefixeBits(bitsFlottant(module, -F));
+    }
+
+    /**
+     * Facteur du préfixe indice en double : les constantes 1.0e-3, 1.0e6...
+     * de la version 1.0.0, qui calculait val * 1.0e-3 en double. Sur AVR
+     * (double = float) c'est le facteur de la table.
+     */
+    static double facteurDouble(int indice) {
+        if (sizeof(double) == sizeof(float)) return pgm_read_float(&tablePrefixes()[indice].facteur);
+        static constexpr double facteurs[] = {
+            1.0e30, 1.0e27, 1.0e24, 1.0e21, 1.0e18, 1.0e15, 1.0e12, 1.0e9, 1.0e6, 1.0e3, 1.0,
+            1.0e-3, 1.0e-6, 1.0e-9, 1.0e-12, 1.0e-15, 1.0e-18, 1.0e-21, 1.0e-24, 1.0e-27, 1.0e-30,
+        };
+        return facteurs[indice];
+    }
+
+    // val ramenée au préfixe indice : float par le facteur en double (même
+    // produit que la version 1.0.0), double par des puissances de 1000
+    // exactes (jusqu'à 1e21)
+    static double echelle(float val, int indice) {
+        return (double)val * facteurDouble(indice);
+    }
+
+    static double echelle(double val, int indice) {
+        double puissance = 1.0;
+        for (int i = indice; i < INDICE_UNITE; i++) puissance *= 1000.0;
+        for (int i = INDICE_UNITE; i < indice; i++) puissance *= 1000.0;
+        return indice < INDICE_UNITE ? val * puissance : val / puissance;
+    }
+
+    /**
+     * Demi-unité de la dernière décimale affichée (0.5 × 10^-nbDecimal)
+     */
+    template <class R>
+    static R demiUnite(int nbDecimal) {
+        R arrondi = (R)0.5;
+        for (int i = 0; i < nbDecimal; i++) arrondi *= (R)0.1;
+        return arrondi;
+    }
+
+    /**
+     * x >= 0 fini arrondi à nbDecimal décimales, exactement comme dtostrf et
+     * printf (au plus proche, pair en cas d'égalité) : x = M × 2^E est
+     * développé en entiers 64 bits, chiffre à chiffre, sans arrondi
+     * intermédiaire. Au-delà de 2^64 la partie entière (jamais de fraction)
+     * est gardée en M et E ; au-delà de MAX_DECIMALES, des zéros.
+     */
+    struct Arrondi {
+        static constexpr int MAX_DECIMALES = 64;
+        uint64_t entier;
+        uint64_t mantisse;  // Si grand : partie entière = mantisse × 2^exposant
+        int exposant;
+        bool grand;
+        char decimales[MAX_DECIMALES];
+    };
+
+    static void arrondir(double x, int nbDecimal, Arrondi& a) {
+        const int bits = DBL_MANT_DIG;
+        int e;
+        double m = frexp(x, &e);
+        uint64_t mantisse = (uint64_t)ldexp(m, bits);
+        int exposant = e - bits;
+        int nb = nbDecimal < Arrondi::MAX_DECIMALES ? nbDecimal : Arrondi::MAX_DECIMALES;
+        a.grand = false;
+        for (int i = 0; i < nb; i++) a.decimales[i] = '0';
+
+        if (exposant >= 0) {
+            if (e > 64) {
+                a.grand = true;
+                a.mantisse = mantisse;
+                a.exposant = exposant;
+            } else {
+                a.entier = mantisse << exposant;
+            }
+            return;
+        }
+
+        // Fraction sur k <= 60 bits : fraction × 10 tient sur 64 bits
+        int k = -exposant;
+        if (k > 60) {
+            mantisse >>= (k - 60 < 64 ? k - 60 : 63);
+            k = 60;
+        }
+        uint64_t masque = ((uint64_t)1 << k) - 1;
+        uint64_t fraction = mantisse & masque;
+        a.entier = mantisse >> k;
+        for (int i = 0; i < nb; i++) {
+            fraction *= 10;
+            a.decimales[i] = (char)('0' + (fraction >> k));
+            fraction &= masque;
+        }
+
+        // Le reste décide, pair en cas d'égalité exacte
+        uint64_t moitie = (uint64_t)1 << (k - 1);
+        bool impair = nb ? (a.decimales[nb - 1] & 1) != 0 : (a.entier & 1) != 0;
+        if (fraction < moitie || (fraction == moitie && !impair)) return;
+        int i = nb - 1;
+        while (i >= 0 && a.decimales[i] == '9') a.decimales[i--] = '0';
+        if (i >= 0) a.decimales[i]++;
+        else a.entier++;
+    }
+
+    static void ecrireArrondi(Tampon& t, const Arrondi& a, int nbDecimal) {
+        if (a.grand) {
+            ecrireGrandEntier(t, a.mantisse, a.exposant);
+        } else {
+            char chiffres[20];
+            int n = 0;
+            uint64_t entier = a.entier;
+            do {
+                chiffres[n++] = '0' + (char)(entier % 10);
+                entier /= 10;
+            } while (entier);
+            while (n) t.ajouter(chiffres[--n]);
+        }
+
+        if (nbDecimal > 0) t.ajouter('.');
+        for (int i = 0; i < nbDecimal; i++) t.ajouter(i < Arrondi::MAX_DECIMALES ? a.decimales[i] : '0');
+    }
+
+    static void ecrireGrandEntier(Tampon& t, uint64_t mantisse, int exposant) {
+        char chiffres[TAILLE_GRAND_ENTIER];
+        int n = chiffresGrandEntier(chiffres, mantisse, exposant);
+        while (n) t.ajouter(chiffres[--n]);
+    }
+
+    // Chiffres (en ordre inverse) de mantisse × 2^exposant, au-delà de 2^64 :
+    // divisions par 10^9 d'un entier en mots de 32 bits. Retourne leur nombre
+    static constexpr size_t TAILLE_GRAND_ENTIER = DBL_MAX_10_EXP + 10;
+
+    static int chiffresGrandEntier(char* chiffres, uint64_t mantisse, int exposant) {
+        uint32_t mots[(DBL_MAX_EXP + 63) / 32 + 1];
+        int nbMots = exposant / 32 + 3;
+        for (int i = 0; i < nbMots; i++) mots[i] = 0;
+        int mot = exposant / 32, decalage = exposant % 32;
+        mots[mot] = (uint32_t)(mantisse << decalage);
+        mots[mot + 1] = (uint32_t)(decalage ? mantisse >> (32 - decalage) : mantisse >> 32);
+        mots[mot + 2] = decalage ? (uint32_t)(mantisse >> (64 - decalage)) : 0;
+
+        int n = 0;
+        while (nbMots > 0 && mots[nbMots - 1] == 0) nbMots--;
+        while (nbMots > 0) {
+            uint64_t reste = 0;
+            for (int i = nbMots - 1; i >= 0; i--) {
+                uint64_t courant = (reste << 32) | mots[i];
+                mots[i] = (uint32_t)(courant / 1000000000UL);
+                reste = courant % 1000000000UL;
+            }
+            while (nbMots > 0 && mots[nbMots - 1] == 0) nbMots--;
+            for (int j = 0; j < 9 && (nbMots > 0 || reste); j++) {
+                chiffres[n++] = '0' + (char)(reste % 10);
+                reste /= 10;
+            }
+        }
+        return n;
+    }
+
+    /**
+     * Écrit un flottant positif avec nbDecimal décimales, sans passer par
+     * String : mêmes chiffres que dtostrf (String(double, nbDecimal))
+     */
+    static void ecrireFlottant(Tampon& t, double val, int nbDecimal) {
+        if (isnan(val)) { t.ajouter("nan"); return; }
+        if (isinf(val)) { t.ajouter("inf"); return; }
+        Arrondi a;
+        arrondir(val, nbDecimal, a);
+        ecrireArrondi(t, a, nbDecimal);
+    }
+
+    /**
+     * Écrit espace, signe, nombre et préfixe (tout sauf le symbole de l'unité)
+     * indice est l'indice de préfixe de |val| (voir indiceValeur)
+     */
+    template <class R>
+    static void ecrireValeurClassee(Tampon& t, R val, int indice, int nbDecimal, bool espaceAvantUnite) {
+        if (espaceAvantUnite) t.ajouter(' ');
+
+        if (estInvalide(val)) {
+            t.ajouter(texteInvalide(val));
+            return;
+        }
+
+        if (val < R(0)) {
+            t.ajouter('-');
             val = -val;
         }
-        
-        // Valeur nulle
-        if (val == 0.0) {
-            result += "0.0";
-            result += unite;
-            return result;
-        }
-        
-        // Conversion avec préfixes (multiplication par l'inverse pour optimisation)
-        if (val >= 1.0e12) {
-            result += String(val * 1.0e-12, nbDecimal);
-            result += "T" + unite;
-        } else if (val >= 1.0e9) {
-            result += String(val * 1.0e-9, nbDecimal);
-            result += "G" + unite;
-        } else if (val >= 1.0e6) {
-            result += String(val * 1.0e-6, nbDecimal);
-            result += "M" + unite;
-        } else if (val >= 1.0e3) {
-            result += String(val * 1.0e-3, nbDecimal);
-            result += "k" + unite;
-        } else if (val >= 1.0) {
-            result += String(val, nbDecimal);
-            result += unite;
-        } else if (val >= 1.0e-3) {
-            result += String(val * 1.0e3, nbDecimal);
-            result += "m" + unite;
-        } else if (val >= 1.0e-6) {
-            result += String(val * 1.0e6, nbDecimal);
-            result += "µ" + unite;
-        } else if (val >= 1.0e-9) {
-            result += String(val * 1.0e9, nbDecimal);
-            result += "n" + unite;
-        } else if (val >= 1.0e-12) {
-            result += String(val * 1.0e12, nbDecimal);
-            result += "p" + unite;
-        } else if (val >= 1.0e-15) {
-            result += String(val * 1.0e15, nbDecimal);
-            result += "f" + unite;
-        } else if (val >= 1.0e-18) {
-            result += String(val * 1.0e18, nbDecimal);
-            result += "a" + unite;
+
+        if (val == R(0)) {
+            t.ajouter("0.0");
+            return;
+        }
+
+        if (indice < 0) {
+            t.ajouter("ε"); // Valeur trop petite
+            return;
+        }
+
+        ecrireMesure(t, val, indice, nbDecimal);
+    }
+
+    static bool estInvalide(float val) { return isnan(val); }
+    static bool estInvalide(double val) { return isnan(val); }
+    template <int F>
+    static bool estInvalide(VirguleFixe<F> val) { return val.brut == VirguleFixe<F>::BRUT_INVALIDE; }
+
+    // nan s'écrit ε comme dans la version 1.0.0 (toutes ses comparaisons y échouaient)
+    static const char* texteInvalide(float) { return "ε"; }
+    static const char* texteInvalide(double) { return "ε"; }
+    template <int F>
+    static const char* texteInvalide(VirguleFixe<F>) { return "nan"; }
+
+    // Moteur de formatage de chaque représentation (val > 0)
+    static void ecrireMesure(Tampon& t, float val, int indice, int nbDecimal) {
+#ifdef UNITY_FORMATAGE_ENTIER
+        ecrireMesureEntiere(t, val, indice, nbDecimal);
+#else
+        ecrireMesureFlottante(t, val, indice, nbDecimal);
+#endif
+    }
+
+    static void ecrireMesure(Tampon& t, double val, int indice, int nbDecimal) {
+        ecrireMesureFlottante(t, val, indice, nbDecimal);
+    }
+
+    template <int F>
+    static void ecrireMesure(Tampon& t, VirguleFixe<F> val, int indice, int nbDecimal) {
+        ecrireMesureEntiere(t, val, indice, nbDecimal);
+    }
+
+    /**
+     * Écrit val > 0 ramenée dans [1, 1000[ par le préfixe indice, puis le préfixe.
+     * L'arrondi peut atteindre 1000 : on passe alors au préfixe suivant
+     * (999.9996 à 3 décimales s'écrit 1.000k et non 1000.000)
+     */
+    template <class R>
+    static void ecrireMesureFlottante(Tampon& t, R val, int indice, int nbDecimal) {
+        if (isinf(val)) {
+            t.ajouter("inf");
         } else {
-            // Valeur trop petite
-            result += "ε"; // GREEK SMALL LETTER EPSILON , code UTF-8 : 0xCEB5  
-            result += unite;
+            Arrondi a;
+            arrondir(echelle(val, indice), nbDecimal, a);
+            if (indice < INDICE_MAX && !a.grand && a.entier >= 1000) arrondir(echelle(val, ++indice), nbDecimal, a);
+            ecrireArrondi(t, a, nbDecimal);
         }
-        
-        return result;
+        t.ajouterP(tablePrefixes()[indice].symbole);
     }
-    
+
     /**
-     * Convertit la valeur stockée avec l'unité appropriée
-     * (Version d'instance)
+     * Idem en arithmétique entière seule, pour les cibles sans FPU (AVR, Cortex-M0)
+     * où chaque opération flottante est une routine logicielle.
+     * val et le facteur du préfixe sont décomposés en mantisse entière et
+     * exposant binaire : leur produit exact (56 bits) est ramené en virgule fixe
+     * 32.28, puis arrondi et chiffres sont obtenus sur des entiers 32 bits.
+     * Choisi à la compilation avec #define UNITY_FORMATAGE_ENTIER
      */
-    String valeurAvecUnite(String unite, int nbDecimal = 3, bool espaceAvantUnite = true) const {
-        return valeurAvecUnite(valeur, unite, nbDecimal, espaceAvantUnite);
+    static void ecrireMesureEntiere(Tampon& t, float val, int indice, int nbDecimal) {
+        uint32_t bits;
+        memcpy(&bits, &val, sizeof(bits));
+        bits &= (uint32_t)0x7FFFFFFF;
+
+        if (bits >= 0x7F800000UL) { // inf (nan est filtré avant)
+            t.ajouter("inf");
+            t.ajouterP(tablePrefixes()[indice].symbole);
+            return;
+        }
+
+        uint32_t mantisse = (bits & 0x7FFFFFUL) | (bits >= 0x00800000UL ? 0x800000UL : 0);
+        int exposant = bits >= 0x00800000UL ? (int)(bits >> 23) - 150 : -149;
+        // Au-delà de 2^32 sous le plus grand préfixe (rare) : tous les chiffres par le moteur flottant
+        if (!ecrireMesureEntiere(t, mantisse, exposant, indice, nbDecimal)) ecrireMesureFlottante(t, val, indice, nbDecimal);
     }
-    
+
+    template <int F>
+    static void ecrireMesureEntiere(Tampon& t, VirguleFixe<F> val, int indice, int nbDecimal) {
+        if (!ecrireMesureEntiere(t, (uint32_t)val.brut, -F, indice, nbDecimal)) {
+            t.ajouter("ovf");  // Inatteignable : |val| < 2^31
+            t.ajouterP(tablePrefixes()[indice].symbole);
+        }
+    }
+
     /**
-     * Formate un nombre avec séparateur de milliers
+     * Cœur du moteur entier : écrit mantisse × 2^exposant (mantisse sur 32 bits,
+     * ce qui couvre aussi la virgule fixe, sans conversion en float).
+     * Faux, sans rien écrire, si la partie entière dépasse 32 bits
      */
-    static String formatNombre(float valeur, int decimales = 0, char separateur = ' ') {
-        String result = String(valeur, decimales);
-        
-        int pointIndex = result.indexOf('.');
-        if (pointIndex == -1) pointIndex = result.length();
-        
-        String partieEntiere = result.substring(0, pointIndex);
-        String partieDecimale = ((unsigned int)pointIndex < result.length()) ? result.substring(pointIndex) : "";
-        
-        String formatted = "";
-        int count = 0;
-        for (int i = partieEntiere.length() - 1; i >= 0; i--) {
-            if (partieEntiere[i] == '-') {
-                formatted = "-" + formatted;
-                break;
+    static bool ecrireMesureEntiere(Tampon& t, uint32_t mantisse, int exposant, int indice, int nbDecimal) {
+        // Demi-unité de la dernière décimale en virgule fixe 28 bits
+        uint32_t demi = 1UL << 27;
+        for (int i = 0; i < nbDecimal && demi; i++) demi /= 10;
+
+        uint32_t entier, fraction;
+        for (;;) {
+            float facteur = pgm_read_float(&tablePrefixes()[indice].facteur);
+            uint32_t f;
+            memcpy(&f, &facteur, sizeof(f));
+            uint64_t produit = (uint64_t)mantisse * ((f & 0x7FFFFFUL) | 0x800000UL);
+            int decalage = exposant + (int)(f >> 23) - 150 + 28; // produit × 2^decalage = val × facteur × 2^28
+
+            uint64_t fixe;
+            if (decalage >= 0) {
+                if (decalage > 0 && (decalage >= 60 || (produit >> (60 - decalage)) != 0)) return false;
+                fixe = produit << decalage;
+            } else {
+                fixe = decalage > -64 ? produit >> -decalage : 0;
             }
-            formatted = String(partieEntiere[i]) + formatted;
-            count++;
-            if (count == 3 && i > 0 && partieEntiere[i-1] != '-') {
-                formatted = String(separateur) + formatted;
-                count = 0;
+
+            entier = (uint32_t)(fixe >> 28);
+            fraction = ((uint32_t)fixe & 0x0FFFFFFFUL) + demi;
+            if (fraction >> 28) {
+                fraction &= 0x0FFFFFFFUL;
+                if (++entier == 0) return false;
             }
+
+            if (entier < 1000 || indice >= INDICE_MAX) break;
+            indice++; // Retenue jusqu'au préfixe suivant
         }
-        
-        return formatted + partieDecimale;
+
+        char chiffres[10];
+        int n = 0;
+        do {
+            chiffres[n++] = '0' + (char)(entier % 10);
+            entier /= 10;
+        } while (entier);
+        while (n) t.ajouter(chiffres[--n]);
+
+        if (nbDecimal > 0) t.ajouter('.');
+        for (int i = 0; i < nbDecimal; i++) {
+            fraction *= 10;
+            t.ajouter((char)('0' + (fraction >> 28)));
+            fraction &= 0x0FFFFFFFUL;
+        }
+
+        t.ajouterP(tablePrefixes()[indice].symbole);
+        return true;
     }
-    
+
+    template <class R>
+    static void ecrireValeur(Tampon& t, R val, int nbDecimal, bool espaceAvantUnite) {
+        ecrireValeurClassee(t, val, indiceValeur(val), nbDecimal, espaceAvantUnite);
+    }
+
     /**
-     * Formate la valeur stockée avec séparateur de milliers
+     * Convertit une valeur avec l'unité appropriée dans un tampon fourni par l'appelant
+     * (Version statique, sans allocation)
+     * Retourne le nombre de caractères écrits (hors '\0'), la sortie étant tronquée à cap - 1
      */
-    String formatNombre(int decimales = 0, char separateur = ' ') const {
-        return formatNombre(valeur, decimales, separateur);
+    static size_t valeurAvecUnite(char* out, size_t cap, float val, const char* unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return ecrireAvecUnite(out, cap, val, unite, nbDecimal, espaceAvantUnite);
     }
-    
+
+    static size_t valeurAvecUnite(char* out, size_t cap, float val, const __FlashStringHelper* unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return ecrireAvecUnite(out, cap, val, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, size_t>::type
+    valeurAvecUnite(char* out, size_t cap, R val, const char* unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return ecrireAvecUnite(out, cap, val, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, size_t>::type
+    valeurAvecUnite(char* out, size_t cap, R val, const __FlashStringHelper* unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return ecrireAvecUnite(out, cap, val, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    // Unite : const char* (RAM) ou const __FlashStringHelper* (flash)
+    template <class R, class Unite>
+    static size_t ecrireAvecUnite(char* out, size_t cap, R val, Unite unite, int nbDecimal, bool espaceAvantUnite) {
+        UNITY_CHRONO(VALEUR_TAMPON);
+        Tampon t(out, cap);
+        ecrireValeur(t, val, nbDecimal, espaceAvantUnite);
+        t.ajouter(unite);
+        return t.terminer();
+    }
+
     // ------------------------------------------------------------------------
-    // CONSTANTES PHYSIQUES UTILES
+    // ÉCRITURE DIRECTE DANS UNE SORTIE (Serial, fichier, écran...)
     // ------------------------------------------------------------------------
-    
-    static constexpr float PI_ = 3.14159265358979323846f;
-    static constexpr float KELVIN_OFFSET = 273.15;
-    static constexpr float CHARGE_ELEMENTAIRE = 1.602176634e-19;
-    static constexpr float CONSTANTE_BOLTZMANN = 1.380649e-23;
-    static constexpr float CONSTANTE_PLANCK = 6.62607015e-34;
-    static constexpr float VITESSE_LUMIERE = 299792458.0;
-    static constexpr float PERMEABILITE_VIDE = 4.0 * PI_ * 1e-7;
-    static constexpr float PERMITTIVITE_VIDE = 8.8541878128e-12;
-    static constexpr float ACCELERATION_GRAVITE = 9.80665;
-    static constexpr float CONSTANTE_GAZ_PARFAIT = 8.314462618;
-    static constexpr float CONSTANTE_FARADAY = 96485.33212;
-    static constexpr float CONSTANTE_STEFAN_BOLTZMANN = 5.670374419e-8;
-};
-
-// ============================================================================
-// MACRO POUR CRÉER DES CLASSES D'UNITÉS (RÉDUIT LE CODE RÉPÉTITIF)
-// ============================================================================
 
-#define DECLARE_UNITY_CLASS(ClassName, UnitSymbol) \
-class ClassName : public C_UNITY { \
-public: \
-    ClassName() : C_UNITY() {} \
-    ClassName(float val) : C_UNITY(val) {} \
-    String afficher(int nbDecimal = 3) const { \
-        return valeurAvecUnite(UnitSymbol, nbDecimal); \
+    /**
+     * Écrit la valeur avec son unité dans une sortie Print, sans String :
+     * chiffres, préfixe et symbole passent par un tampon de TAILLE_NOMBRE
+     * octets sur la pile, envoyé en un seul write() (symbole de moins de
+     * ~30 caractères). Retourne le nombre d'octets envoyés.
+     * Ex : Serial.print("Tension: "); Tension::afficher(Serial, v, 2); Serial.println();
+     */
+    static size_t valeurAvecUnite(Print& sortie, float val, const char* unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return envoyerAvecUnite(sortie, val, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    static size_t valeurAvecUnite(Print& sortie, float val, const __FlashStringHelper* unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return envoyerAvecUnite(sortie, val, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, size_t>::type
+    valeurAvecUnite(Print& sortie, R val, const char* unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return envoyerAvecUnite(sortie, val, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, size_t>::type
+    valeurAvecUnite(Print& sortie, R val, const __FlashStringHelper* unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return envoyerAvecUnite(sortie, val, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R, class Unite>
+    static size_t envoyerAvecUnite(Print& sortie, R val, Unite unite, int nbDecimal, bool espaceAvantUnite) {
+        UNITY_CHRONO(VALEUR_SORTIE);
+        char pile[TAILLE_NOMBRE];
+        Tampon t(pile, sizeof(pile), sortie);
+        ecrireValeur(t, val, nbDecimal, espaceAvantUnite);
+        t.ajouter(unite);
+        return t.terminer();
+    }
+
+    /**
+     * Sortie à tampon d'écriture groupée : accumule les petits print() d'un
+     * rapport (libellés, valeurs, fins de ligne) et les transmet à la sortie
+     * par blocs de N octets. Le reste part avec vider(), flush() ou à la
+     * destruction. Ex :
+     *   C_UNITY::SortieGroupee<64> rapport(Serial);
+     *   rapport.print("Tension: "); Tension::afficher(rapport, v, 2); rapport.println();
+     */
+    template <size_t N>
+    class SortieGroupee : public Print {
+    public:
+        explicit SortieGroupee(Print& s) : sortie(s), len(0) {}
+        ~SortieGroupee() { vider(); }
+
+        using Print::write;
+
+        size_t write(uint8_t c) override {
+            if (len == N) vider();
+            bloc[len++] = c;
+            return 1;
+        }
+
+        size_t write(const uint8_t* donnees, size_t taille) override {
+            if (len + taille > N) {
+                vider();
+                if (taille >= N) return sortie.write(donnees, taille); // Trop long : direct
+            }
+            memcpy(bloc + len, donnees, taille);
+            len += taille;
+            return taille;
+        }
+
+        void vider() {
+            if (len) sortie.write(bloc, len);
+            len = 0;
+        }
+
+        void flush() override {
+            vider();
+            sortie.flush();
+        }
+
+    private:
+        Print& sortie;
+        size_t len;
+        uint8_t bloc[N];
+    };
+
+    // ------------------------------------------------------------------------
+    // FORMATAGE PAR LOTS (TABLEAUX DE MESURES)
+    // ------------------------------------------------------------------------
+
+    static constexpr size_t TAILLE_BLOC = 32;      // Valeurs classées par passe
+    static constexpr uint8_t INDICE_EPSILON = 0xFF; // |val| trop petite (ou nulle)
+
+    /**
+     * Classe n valeurs par préfixe SI en une passe sans branchement,
+     * écrite pour être vectorisée par le compilateur (SSE/AVX, NEON)
+     */
+    static void classerPrefixes(const float* vals, uint8_t* indices, size_t n) {
+        // Copie locale des seuils : lue une fois en flash, et sans alias
+        // possible avec indices (ce qui bloquerait la vectorisation)
+        uint32_t seuils[INDICE_MAX + 1];
+        for (int i = INDICE_MIN; i <= INDICE_MAX; i++) seuils[i] = pgm_read_dword(&tablePrefixes()[i].seuil);
+
+        for (size_t k = 0; k < n; k++) {
+            uint32_t bits;
+            memcpy(&bits, &vals[k], sizeof(bits));
+            bits &= (uint32_t)0x7FFFFFFF; // |val|
+
+            int indice = (int)((uint16_t)((uint16_t)(bits >> 23) * 103u + 231u) >> 10) - 3;
+            indice = indice < INDICE_MIN - 1 ? INDICE_MIN - 1 : indice;
+            indice = indice > INDICE_MAX ? INDICE_MAX : indice;
+            int suivant = indice < INDICE_MAX ? indice + 1 : INDICE_MAX;
+            indice += (indice < INDICE_MAX) & (bits >= seuils[suivant]);
+            indices[k] = indice < INDICE_MIN ? INDICE_EPSILON : (uint8_t)indice;
+        }
+    }
+
+    /**
+     * Formate n valeurs dans un seul tampon, séparées par separateur
+     * (ex. " 3.300V; 5.000mV"). Les préfixes sont choisis par blocs avec
+     * classerPrefixes, puis chaque valeur est écrite sans allocation.
+     * Retourne le nombre de caractères écrits (hors '\0')
+     */
+    static size_t valeursAvecUnite(char* out, size_t cap, const float* vals, size_t n, const char* unite,
+                                   char separateur = ';', int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return ecrireLot(out, cap, vals, n, unite, separateur, nbDecimal, espaceAvantUnite);
+    }
+
+    static size_t valeursAvecUnite(char* out, size_t cap, const float* vals, size_t n, const __FlashStringHelper* unite,
+                                   char separateur = ';', int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return ecrireLot(out, cap, vals, n, unite, separateur, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, size_t>::type
+    valeursAvecUnite(char* out, size_t cap, const R* vals, size_t n, const char* unite,
+                     char separateur = ';', int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return ecrireLot(out, cap, vals, n, unite, separateur, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, size_t>::type
+    valeursAvecUnite(char* out, size_t cap, const R* vals, size_t n, const __FlashStringHelper* unite,
+                     char separateur = ';', int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return ecrireLot(out, cap, vals, n, unite, separateur, nbDecimal, espaceAvantUnite);
+    }
+
+    // Classement d'un bloc : vectorisé pour float, valeur par valeur sinon
+    static void classerLot(const float* vals, uint8_t* indices, size_t n) {
+        classerPrefixes(vals, indices, n);
+    }
+
+    template <class R>
+    static void classerLot(const R* vals, uint8_t* indices, size_t n) {
+        for (size_t k = 0; k < n; k++) {
+            int indice = indiceValeur(vals[k]);
+            indices[k] = indice < 0 ? INDICE_EPSILON : (uint8_t)indice;
+        }
+    }
+
+    /**
+     * Idem dans une sortie Print, sans limite de longueur : le tampon de
+     * TAILLE_NOMBRE octets est envoyé à chaque remplissage
+     */
+    static size_t valeursAvecUnite(Print& sortie, const float* vals, size_t n, const char* unite,
+                                   char separateur = ';', int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return envoyerLot(sortie, vals, n, unite, separateur, nbDecimal, espaceAvantUnite);
+    }
+
+    static size_t valeursAvecUnite(Print& sortie, const float* vals, size_t n, const __FlashStringHelper* unite,
+                                   char separateur = ';', int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return envoyerLot(sortie, vals, n, unite, separateur, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, size_t>::type
+    valeursAvecUnite(Print& sortie, const R* vals, size_t n, const char* unite,
+                     char separateur = ';', int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return envoyerLot(sortie, vals, n, unite, separateur, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, size_t>::type
+    valeursAvecUnite(Print& sortie, const R* vals, size_t n, const __FlashStringHelper* unite,
+                     char separateur = ';', int nbDecimal = 3, bool espaceAvantUnite = true) {
+        return envoyerLot(sortie, vals, n, unite, separateur, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R, class Unite>
+    static size_t ecrireLot(char* out, size_t cap, const R* vals, size_t n, Unite unite,
+                            char separateur, int nbDecimal, bool espaceAvantUnite) {
+        Tampon t(out, cap);
+        return ecrireLot(t, vals, n, unite, separateur, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R, class Unite>
+    static size_t envoyerLot(Print& sortie, const R* vals, size_t n, Unite unite,
+                             char separateur, int nbDecimal, bool espaceAvantUnite) {
+        char pile[TAILLE_NOMBRE];
+        Tampon t(pile, sizeof(pile), sortie);
+        return ecrireLot(t, vals, n, unite, separateur, nbDecimal, espaceAvantUnite);
+    }
+
+    template <class R, class Unite>
+    static size_t ecrireLot(Tampon& t, const R* vals, size_t n, Unite unite,
+                            char separateur, int nbDecimal, bool espaceAvantUnite) {
+        UNITY_CHRONO(VALEURS_LOT);
+        uint8_t indices[TAILLE_BLOC];
+
+        for (size_t debut = 0; debut < n; debut += TAILLE_BLOC) {
+            size_t taille = n - debut < TAILLE_BLOC ? n - debut : TAILLE_BLOC;
+            classerLot(vals + debut, indices, taille);
+
+            for (size_t k = 0; k < taille; k++) {
+                if (debut + k > 0) t.ajouter(separateur);
+                int indice = indices[k] == INDICE_EPSILON ? -1 : indices[k];
+                ecrireValeurClassee(t, vals[debut + k], indice, nbDecimal, espaceAvantUnite);
+                t.ajouter(unite);
+            }
+            if (t.plein()) break; // Tampon plein : inutile de classer la suite
+        }
+        return t.terminer();
+    }
+
+    // ------------------------------------------------------------------------
+    // NOMBRES AVEC SÉPARATEUR DE MILLIERS
+    // ------------------------------------------------------------------------
+
+    /**
+     * Formate un nombre avec séparateur de milliers
+     */
+    static String formatNombre(float valeur, int decimales = 0, char separateur = ' ') {
+        return chaineNombre((double)valeur, decimales, separateur);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, String>::type
+    formatNombre(R valeur, int decimales = 0, char separateur = ' ') {
+        return chaineNombre(valeur, decimales, separateur);
+    }
+
+    /**
+     * Idem dans un tampon fourni par l'appelant, en une passe et sans allocation.
+     * separateur : un caractère ou une chaîne UTF-8 (ex. " ", espace fine),
+     * inséré tous les groupe chiffres (0 : aucun) ; virgule : marque décimale.
+     *   formatNombre(tampon, sizeof(tampon), 1234567.891, 2, ' ', 3, ',')  // "1 234 567,89"
+     * Retourne le nombre de caractères écrits (hors '\0'), la sortie étant tronquée à cap - 1
+     */
+    static size_t formatNombre(char* out, size_t cap, float valeur, int decimales = 0, char separateur = ' ',
+                               uint8_t groupe = 3, char virgule = '.') {
+        return ecrireNombreTampon(out, cap, (double)valeur, decimales, separateur, groupe, virgule);
+    }
+
+    static size_t formatNombre(char* out, size_t cap, float valeur, int decimales, const char* separateur,
+                               uint8_t groupe = 3, char virgule = '.') {
+        return ecrireNombreTampon(out, cap, (double)valeur, decimales, separateur, groupe, virgule);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, size_t>::type
+    formatNombre(char* out, size_t cap, R valeur, int decimales = 0, char separateur = ' ',
+                 uint8_t groupe = 3, char virgule = '.') {
+        return ecrireNombreTampon(out, cap, valeur, decimales, separateur, groupe, virgule);
+    }
+
+    template <class R>
+    static typename ActiverSi<ScalaireUnity<R>::etendu, size_t>::type
+    formatNombre(char* out, size_t cap, R valeur, int decimales, const char* separateur,
+                 uint8_t groupe = 3, char virgule = '.') {
+        return ecrireNombreTampon(out, cap, valeur, decimales, separateur, groupe, virgule);
+    }
+
+    template <class R, class S>
+    static size_t ecrireNombreTampon(char* out, size_t cap, R valeur, int decimales, S separateur,
+                                     uint8_t groupe, char virgule) {
+        UNITY_CHRONO(FORMAT_NOMBRE_TAMPON);
+        Tampon t(out, cap);
+        ecrireNombre(t, valeur, decimales, separateur, groupe, virgule);
+        return t.terminer();
+    }
+
+    /**
+     * Version String : nombre écrit sur la pile, puis une seule allocation.
+     * Un nombre plus long que la pile (double au-delà de 1e35, ou nombreuses
+     * décimales) est écrit dans un tampon du tas à sa taille exacte.
+     * Comme la version 1.0.0 (dtostrf), un nombre positif est complété par
+     * des espaces à la largeur decimales + 2 : " 5", "  nan". Les versions
+     * tampon et Print n'ajoutent pas ces espaces.
+     */
+    template <class R>
+    static String chaineNombre(R valeur, int decimales, char separateur) {
+        UNITY_CHRONO(FORMAT_NOMBRE);
+        char pile[TAILLE_NOMBRE];
+        Tampon t(pile, sizeof(pile));
+        size_t longueur = ecrireNombre(t, valeur, decimales, separateur, 3, '.');
+        size_t largeur = (size_t)(decimales > 0 ? decimales : 0) + 2;
+        size_t espaces = 0;
+        if (longueur < largeur && !signbit(ScalaireUnity<R>::versDouble(valeur))) espaces = largeur - longueur;
+        longueur += espaces;
+        UNITY_ALLOCATION(FORMAT_NOMBRE, longueur + 1);
+        if (longueur < sizeof(pile)) {
+            memmove(pile + espaces, pile, longueur - espaces);
+            memset(pile, ' ', espaces);
+            pile[longueur] = '\0';
+            return String(pile);
+        }
+
+        UNITY_ALLOCATION(FORMAT_NOMBRE, longueur + 1);  // Tampon provisoire
+        char* tas = (char*)malloc(longueur + 1);
+        if (!tas) return String();
+        Tampon grand(tas, longueur + 1);
+        for (size_t i = 0; i < espaces; i++) grand.ajouter(' ');
+        ecrireNombre(grand, valeur, decimales, separateur, 3, '.');
+        grand.terminer();
+        String result(tas);
+        free(tas);
+        return result;
+    }
+
+    static size_t longueurSeparateur(char) { return 1; }
+    static size_t longueurSeparateur(const char* s) { return strlen(s); }
+
+    /**
+     * Écrit le signe et la partie entière groupée : n chiffres (en ordre
+     * inverse) suivis de zeros zéros. Chaque chiffre n'est écrit qu'une fois,
+     * le premier groupe est calculé d'avance (une seule division).
+     * Retourne le nombre de caractères nécessaires, écrits ou non
+     */
+    template <class S>
+    static size_t ecrireEntierGroupe(Tampon& t, bool negatif, const char* chiffres, int n, int zeros,
+                                     S separateur, uint8_t groupe) {
+        int total = n + zeros;
+        if (negatif) t.ajouter('-');
+
+        int avant = groupe ? total % groupe : total;
+        if (avant == 0) avant = groupe;
+        for (int i = total - 1; i >= 0; i--) {
+            t.ajouter(i >= zeros ? chiffres[i - zeros] : '0');
+            if (--avant == 0 && i > 0) {
+                t.ajouter(separateur);
+                avant = groupe;
+            }
+        }
+
+        size_t separateurs = groupe ? (size_t)((total - 1) / groupe) : 0;
+        return (negatif ? 1 : 0) + (size_t)total + separateurs * longueurSeparateur(separateur);
+    }
+
+    // Chiffres de e en ordre inverse, retourne leur nombre
+    template <class E>
+    static int chiffresInverses(char* chiffres, E e) {
+        int n = 0;
+        do {
+            chiffres[n++] = '0' + (char)(e % 10);
+            e /= 10;
+        } while (e);
+        return n;
+    }
+
+    static uint32_t puissance10(int n) {  // n <= 9
+        uint32_t p = 1;
+        while (n-- > 0) p *= 10;
+        return p;
+    }
+
+    /**
+     * Écrit entier (groupé), virgule, puis fraction sur decimales chiffres
+     * (fraction < 10^decimales, decimales <= 9) suivis de zerosDecimaux zéros
+     */
+    template <class E, class S>
+    static size_t ecrireDecimal(Tampon& t, bool negatif, E entier, uint32_t fraction, int decimales, int zerosDecimaux,
+                                S separateur, uint8_t groupe, char virgule) {
+        char chiffres[20];
+        int n = chiffresInverses(chiffres, entier);
+        size_t longueur = ecrireEntierGroupe(t, negatif, chiffres, n, 0, separateur, groupe);
+
+        int total = decimales + zerosDecimaux;
+        if (total == 0) return longueur;
+        t.ajouter(virgule);
+        memset(chiffres, '0', sizeof(chiffres));  // Zéros de tête (0.05)
+        chiffresInverses(chiffres, fraction);
+        for (int i = decimales - 1; i >= 0; i--) t.ajouter(chiffres[i]);
+        for (int i = 0; i < zerosDecimaux; i++) t.ajouter('0');
+        return longueur + 1 + (size_t)total;
+    }
+
+    // x >= 0 arrondi à l'entier le plus proche, pair en cas d'égalité (comme printf)
+    template <class E>
+    static E arrondiPair(double x) {
+        E r = (E)x;
+        double reste = x - (double)r;
+        if (reste > 0.5 || (reste == 0.5 && (r & 1))) r++;
+        return r;
+    }
+
+    /**
+     * float et double, arrondis au plus proche (pair en cas d'égalité) :
+     * - cas courant, valeur × 10^decimales < 2^32 : un arrondi, puis chiffres
+     *   en entiers 32 bits ;
+     * - sinon partie entière (64 bits) et fraction séparées : la fraction est
+     *   exacte, son produit par 10^decimales aussi dès que la partie entière
+     *   est grande ;
+     * - au-delà de 2^64 ou de 9 décimales, développement exact du double
+     *   (arrondir), tous ses chiffres comme dtostrf.
+     * Retourne le nombre de caractères nécessaires (la sortie peut être tronquée)
+     */
+    template <class S>
+    static size_t ecrireNombre(Tampon& t, double valeur, int decimales, S separateur, uint8_t groupe, char virgule) {
+        bool negatif = signbit(valeur);  // -0.0 et -nan compris, comme String(float)
+        if (negatif) valeur = -valeur;
+        if (isnan(valeur) || isinf(valeur)) {
+            if (negatif) t.ajouter('-');
+            t.ajouter(isnan(valeur) ? "nan" : "inf");
+            return negatif ? 4 : 3;
+        }
+        if (decimales < 0) decimales = 0;
+
+        if (decimales <= 9) {
+            uint32_t p = puissance10(decimales);
+            double x = valeur * (double)p;
+            if (x < 4294967295.5) {
+                uint32_t r = arrondiPair<uint32_t>(x);
+                return ecrireDecimal(t, negatif, r / p, r % p, decimales, 0, separateur, groupe, virgule);
+            }
+            if (valeur < 18446744073709549568.0) {  // Plus grand double < 2^64
+                uint64_t entier = (uint64_t)valeur;
+                double decalee = (valeur - (double)entier) * (double)p;
+                uint32_t fraction = (uint32_t)decalee;
+                double reste = decalee - (double)fraction;
+                bool impair = ((decimales ? fraction : (uint32_t)entier) & 1) != 0;  // Dernier chiffre écrit
+                if (reste > 0.5 || (reste == 0.5 && impair)) fraction++;
+                if (fraction >= p) { fraction -= p; entier++; }
+                return ecrireDecimal(t, negatif, entier, fraction, decimales, 0, separateur, groupe, virgule);
+            }
+        }
+
+        Arrondi a;
+        arrondir(valeur, decimales, a);
+        char chiffres[TAILLE_GRAND_ENTIER];
+        int n = a.grand ? chiffresGrandEntier(chiffres, a.mantisse, a.exposant) : chiffresInverses(chiffres, a.entier);
+        size_t longueur = ecrireEntierGroupe(t, negatif, chiffres, n, 0, separateur, groupe);
+        if (decimales > 0) t.ajouter(virgule);
+        for (int i = 0; i < decimales; i++) t.ajouter(i < Arrondi::MAX_DECIMALES ? a.decimales[i] : '0');
+        return longueur + (decimales > 0 ? 1 + (size_t)decimales : 0);
+    }
+
+    /**
+     * Virgule fixe : partie entière lue dans la valeur brute, fraction
+     * × 10^decimales calculée exactement en entiers 64 bits et arrondie au
+     * plus proche (pair en cas d'égalité). Aucune opération flottante ;
+     * au-delà de 9 décimales, des zéros
+     */
+    template <int F, class S>
+    static size_t ecrireNombre(Tampon& t, VirguleFixe<F> valeur, int decimales, S separateur, uint8_t groupe, char virgule) {
+        if (valeur.brut == VirguleFixe<F>::BRUT_INVALIDE) { t.ajouter("nan"); return 3; }
+        if (decimales < 0) decimales = 0;
+        int exactes = decimales < 9 ? decimales : 9;
+        uint32_t p = puissance10(exactes);
+
+        bool negatif = valeur.brut < 0;
+        uint32_t module = negatif ? 0u - (uint32_t)valeur.brut : (uint32_t)valeur.brut;
+        uint32_t entier = module >> F;
+        uint64_t produit = (uint64_t)(module & (((uint32_t)1 << F) - 1)) * p;
+        uint32_t fraction = (uint32_t)(produit >> F);
+        uint64_t reste = produit & (((uint64_t)1 << F) - 1);
+        uint64_t moitie = (uint64_t)1 << (F - 1);
+        bool impair = ((exactes ? fraction : entier) & 1) != 0;  // Dernier chiffre écrit
+        if (reste > moitie || (reste == moitie && impair)) fraction++;
+        if (fraction >= p) { fraction -= p; entier++; }
+
+        return ecrireDecimal(t, negatif, entier, fraction, exactes, decimales - exactes, separateur, groupe, virgule);
+    }
+
+    // ------------------------------------------------------------------------
+    // LECTURE D'UNE VALEUR FORMATÉE (INVERSE DE valeurAvecUnite)
+    // ------------------------------------------------------------------------
+
+    /**
+     * Nombre décimal lu sans atof/strtod : mantisse entière (9 chiffres
+     * significatifs, les suivants ne font que décaler l'exposant) × 10^exposant
+     */
+    struct NombreLu {
+        uint32_t mantisse;
+        int exposant;
+        bool negatif;
+    };
+
+    static bool estChiffre(char c) { return c >= '0' && c <= '9'; }
+
+    static const char* sauterEspaces(const char* p, const char* fin) {
+        while (p < fin && (*p == ' ' || *p == '\t')) p++;
+        return p;
+    }
+
+    /**
+     * Lit [signe] chiffres [. chiffres] [e|E [signe] chiffres].
+     * Un e/E qui n'est pas suivi d'un chiffre est laissé au préfixe (E = exa).
+     * Retourne la position après le nombre, ou nullptr s'il n'y en a pas
+     */
+    static const char* lireNombre(const char* p, const char* fin, NombreLu& n) {
+        n.mantisse = 0;
+        n.exposant = 0;
+        n.negatif = false;
+        if (p < fin && (*p == '-' || *p == '+')) n.negatif = (*p++ == '-');
+
+        bool chiffres = false;
+        uint8_t significatifs = 0;
+        for (bool fraction = false; p < fin; p++) {
+            if (*p == '.' && !fraction) { fraction = true; continue; }
+            if (!estChiffre(*p)) break;
+            chiffres = true;
+            if (significatifs < 9) {
+                n.mantisse = n.mantisse * 10 + (uint32_t)(*p - '0');
+                if (n.mantisse) significatifs++;
+                if (fraction) n.exposant--;
+            } else if (!fraction) {
+                n.exposant++;
+            }
+        }
+        if (!chiffres) return nullptr;
+
+        if (p < fin && (*p == 'e' || *p == 'E')) {
+            const char* q = p + 1;
+            bool negatif = false;
+            if (q < fin && (*q == '-' || *q == '+')) negatif = (*q++ == '-');
+            if (q < fin && estChiffre(*q)) {
+                int exposant = 0;
+                for (; q < fin && estChiffre(*q); q++) {
+                    if (exposant < 1000) exposant = exposant * 10 + (*q - '0');
+                }
+                n.exposant += negatif ? -exposant : exposant;
+                p = q;
+            }
+        }
+        return p;
+    }
+
+    /**
+     * Préfixe SI en tête de [p, fin[ : indice dans tablePrefixes (toute la
+     * table, quecto à quetta) et nombre d'octets lus, 0 s'il n'y en a pas.
+     * µ est accepté en UTF-8 (signe micro U+00B5 ou mu grec U+03BC) et sous
+     * la forme ASCII u.
+     */
+    static uint8_t lirePrefixe(const char* p, const char* fin, int& indice) {
+        if (p >= fin) return 0;
+        switch (*p) {
+            case 'q': indice = 0;  return 1;
+            case 'r': indice = 1;  return 1;
+            case 'y': indice = 2;  return 1;
+            case 'z': indice = 3;  return 1;
+            case 'a': indice = 4;  return 1;
+            case 'f': indice = 5;  return 1;
+            case 'p': indice = 6;  return 1;
+            case 'n': indice = 7;  return 1;
+            case 'u': indice = 8;  return 1;
+            case 'm': indice = 9;  return 1;
+            case 'k': indice = 11; return 1;
+            case 'M': indice = 12; return 1;
+            case 'G': indice = 13; return 1;
+            case 'T': indice = 14; return 1;
+            case 'P': indice = 15; return 1;
+            case 'E': indice = 16; return 1;
+            case 'Z': indice = 17; return 1;
+            case 'Y': indice = 18; return 1;
+            case 'R': indice = 19; return 1;
+            case 'Q': indice = 20; return 1;
+            case '\xC2': // µ (U+00B5)
+                if (p + 1 < fin && p[1] == '\xB5') { indice = 8; return 2; }
+                return 0;
+            case '\xCE': // μ (U+03BC)
+                if (p + 1 < fin && p[1] == '\xBC') { indice = 8; return 2; }
+                return 0;
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * mantisse × 10^exposant dans la représentation R (float ou double) :
+     * une puissance de 10 construite par carrés successifs, en division pour
+     * les exposants négatifs (1e3 est exact, 1e-3 ne l'est pas).
+     * Retourne false, sans modifier valeur, si le résultat dépasse la plage
+     * de R ("1e40" en float) : comme strtod (ERANGE), pas de lecture en inf
+     */
+    template <class R>
+    static bool valeurLue(const NombreLu& n, int exposant, R& valeur) {
+        R lu = (R)n.mantisse;
+        if (n.mantisse != 0 && exposant != 0) {
+            unsigned int reste = exposant < 0 ? (unsigned int)-exposant : (unsigned int)exposant;
+            R puissance = 1;
+            for (R carre = 10; reste; reste >>= 1, carre *= carre) {
+                if (reste & 1) puissance *= carre;
+            }
+            lu = exposant < 0 ? lu / puissance : lu * puissance;
+        }
+        if (isinf(lu)) return false;
+        valeur = n.negatif ? -lu : lu;
+        return true;
+    }
+
+    // [p, p + n[ est-il exactement le symbole en flash ?
+    static bool memeSymbole(const char* p, size_t n, const __FlashStringHelper* symbole) {
+        const char* s = reinterpret_cast<const char*>(symbole);
+        for (size_t k = 0; k < n; k++) {
+            if ((char)pgm_read_byte(s + k) != p[k]) return false;
+        }
+        return pgm_read_byte(s + n) == '\0';
+    }
+
+    // Fin de [p, fin[ sans les espaces de queue
+    static const char* finSansEspaces(const char* p, const char* fin) {
+        while (fin > p && (fin[-1] == ' ' || fin[-1] == '\t')) fin--;
+        return fin;
+    }
+
+    /**
+     * Lit "4.7kΩ", "4.700 kΩ", "100nF" ou "4700" (unité sous-entendue) dans
+     * l'unité attendue. Le symbole exact est essayé avant la lecture d'un
+     * préfixe : "ms" attendu reste "ms", pas milli-"s".
+     * Retourne false si le texte n'est pas un nombre suivi de ce symbole,
+     * ou si le nombre dépasse la plage de R (voir valeurLue).
+     */
+    template <class R>
+    static bool lireAvecUnite(const char* debut, const char* fin, const __FlashStringHelper* unite, R& valeur) {
+        NombreLu n;
+        const char* p = lireNombre(sauterEspaces(debut, fin), fin, n);
+        if (!p) return false;
+        p = sauterEspaces(p, fin);
+        fin = finSansEspaces(p, fin);
+
+        if (p == fin || memeSymbole(p, (size_t)(fin - p), unite)) {
+            return valeurLue(n, n.exposant, valeur);
+        }
+
+        int indice;
+        uint8_t lus = lirePrefixe(p, fin, indice);
+        if (!lus) return false;
+        p += lus;
+        if (p != fin && !memeSymbole(p, (size_t)(fin - p), unite)) return false;
+        return valeurLue(n, n.exposant + 3 * (indice - INDICE_UNITE), valeur);
+    }
+    
+};
+
+// ============================================================================
+// CLASSE C_UNITY GÉNÉRIQUE
+// ============================================================================
+
+/**
+ * Valeur physique stockée dans le type T :
+ *   float            (par défaut, C_UNITY)
+ *   double           totaux de comptage, constantes sans perte de précision
+ *   VirguleFixe<F>   cartes sans FPU : calculs et formatage en entiers
+ */
+template <class T = float>
+class C_UNITY_T : public C_UNITY_BASE {
+protected:
+    T valeur;  // Valeur stockée pour les méthodes d'instance
+
+public:
+    typedef T Scalaire;
+    typedef typename ScalaireUnity<T>::Constante Constante;
+
+    // Constructeurs
+    C_UNITY_T() : valeur(0.0) {}
+    C_UNITY_T(T val) : valeur(val) {}
+    
+    // Méthodes d'accès
+    T getValeur() const { return valeur; }
+    void setValeur(T val) { valeur = val; }
+
+    // Opérateurs arithmétiques simplifiés (retournent C_UNITY_T)
+    C_UNITY_T operator+(const C_UNITY_T& other) const {
+        return C_UNITY_T(valeur + other.valeur);
+    }
+
+    C_UNITY_T operator-(const C_UNITY_T& other) const {
+        return C_UNITY_T(valeur - other.valeur);
+    }
+    
+    C_UNITY_T operator*(const C_UNITY_T& other) const {
+        return C_UNITY_T(valeur * other.valeur);
+    }
+
+    C_UNITY_T operator/(const C_UNITY_T& other) const {
+        if (other.valeur != T(0)) return C_UNITY_T(valeur / other.valeur); // Évite la division par zéro
+        else return ScalaireUnity<T>::invalide();
+    }
+    
+    // Opérateurs avec des scalaires du même type
+    C_UNITY_T operator+(T val) const {
+        return C_UNITY_T(valeur + val);
+    }
+
+    C_UNITY_T operator-(T val) const {
+        return C_UNITY_T(valeur - val);
+    }
+    
+    C_UNITY_T operator*(T val) const {
+        return C_UNITY_T(valeur * val);
+    }
+
+    C_UNITY_T operator/(T val) const {
+        if (val != T(0)) return C_UNITY_T(valeur / val); // Évite la division par zéro
+        else return ScalaireUnity<T>::invalide();
+    }
+    
+    // Opérateur de conversion vers T (simplifie les calculs)
+    operator T() const {
+        return valeur;
+    }
+    
+    // Opérateurs de comparaison
+    bool operator==(const C_UNITY_T& other) const {
+        return valeur == other.valeur;
+    }
+    
+    bool operator!=(const C_UNITY_T& other) const {
+        return valeur != other.valeur;
+    }
+    
+    bool operator<(const C_UNITY_T& other) const {
+        return valeur < other.valeur;
+    }
+    
+    bool operator>(const C_UNITY_T& other) const {
+        return valeur > other.valeur;
+    }
+    
+    bool operator<=(const C_UNITY_T& other) const {
+        return valeur <= other.valeur;
+    }
+    
+    bool operator>=(const C_UNITY_T& other) const {
+        return valeur >= other.valeur;
+    }
+
+    // Versions statiques de C_UNITY_BASE (masquées sinon par les versions d'instance)
+    using C_UNITY_BASE::valeurAvecUnite;
+    using C_UNITY_BASE::formatNombre;
+    
+    /**
+     * Convertit la valeur stockée avec l'unité appropriée
+     * (Version d'instance)
+     */
+    String valeurAvecUnite(String unite, int nbDecimal = 3, bool espaceAvantUnite = true) const {
+        return valeurAvecUnite(valeur, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    String valeurAvecUnite(const __FlashStringHelper* unite, int nbDecimal = 3, bool espaceAvantUnite = true) const {
+        return valeurAvecUnite(valeur, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    /**
+     * Convertit la valeur stockée dans un tampon fourni par l'appelant
+     * (Version d'instance, sans allocation)
+     */
+    size_t valeurAvecUnite(char* out, size_t cap, const char* unite, int nbDecimal = 3, bool espaceAvantUnite = true) const {
+        return ecrireAvecUnite(out, cap, valeur, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    size_t valeurAvecUnite(char* out, size_t cap, const __FlashStringHelper* unite, int nbDecimal = 3, bool espaceAvantUnite = true) const {
+        return ecrireAvecUnite(out, cap, valeur, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    // Idem dans une sortie Print (Serial...), sans String
+    size_t valeurAvecUnite(Print& sortie, const char* unite, int nbDecimal = 3, bool espaceAvantUnite = true) const {
+        return envoyerAvecUnite(sortie, valeur, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    size_t valeurAvecUnite(Print& sortie, const __FlashStringHelper* unite, int nbDecimal = 3, bool espaceAvantUnite = true) const {
+        return envoyerAvecUnite(sortie, valeur, unite, nbDecimal, espaceAvantUnite);
+    }
+
+    /**
+     * Formate la valeur stockée avec séparateur de milliers
+     */
+    String formatNombre(int decimales = 0, char separateur = ' ') const {
+        return formatNombre(valeur, decimales, separateur);
+    }
+
+    size_t formatNombre(char* out, size_t cap, int decimales = 0, char separateur = ' ',
+                        uint8_t groupe = 3, char virgule = '.') const {
+        return formatNombre(out, cap, valeur, decimales, separateur, groupe, virgule);
+    }
+    
+    // ------------------------------------------------------------------------
+    // CONSTANTES PHYSIQUES UTILES
+    // ------------------------------------------------------------------------
+    // Du type Constante : double pour C_UNITY_T<double> (h² ne s'annule plus),
+    // float sinon (la virgule fixe ne couvre pas leur plage)
+    
+    static constexpr Constante PI_ = 3.14159265358979323846;
+    static constexpr Constante KELVIN_OFFSET = 273.15;
+    static constexpr Constante CHARGE_ELEMENTAIRE = 1.602176634e-19;
+    static constexpr Constante CONSTANTE_BOLTZMANN = 1.380649e-23;
+    static constexpr Constante CONSTANTE_PLANCK = 6.62607015e-34;
+    static constexpr Constante VITESSE_LUMIERE = 299792458.0;
+    static constexpr Constante PERMEABILITE_VIDE = 4.0 * PI_ * 1e-7;
+    static constexpr Constante PERMITTIVITE_VIDE = 8.8541878128e-12;
+    static constexpr Constante ACCELERATION_GRAVITE = 9.80665;
+    static constexpr Constante CONSTANTE_GAZ_PARFAIT = 8.314462618;
+    static constexpr Constante CONSTANTE_FARADAY = 96485.33212;
+    static constexpr Constante CONSTANTE_STEFAN_BOLTZMANN = 5.670374419e-8;
+};
+
+// Définitions des constantes (pour les passer par référence)
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::PI_;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::KELVIN_OFFSET;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::CHARGE_ELEMENTAIRE;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::CONSTANTE_BOLTZMANN;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::CONSTANTE_PLANCK;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::VITESSE_LUMIERE;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::PERMEABILITE_VIDE;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::PERMITTIVITE_VIDE;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::ACCELERATION_GRAVITE;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::CONSTANTE_GAZ_PARFAIT;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::CONSTANTE_FARADAY;
+template <class T> constexpr typename C_UNITY_T<T>::Constante C_UNITY_T<T>::CONSTANTE_STEFAN_BOLTZMANN;
+
+// Représentation par défaut : les croquis existants compilent sans changement
+typedef C_UNITY_T<float> C_UNITY;
+
+// ============================================================================
+// ANALYSE DIMENSIONNELLE À LA COMPILATION
+// ============================================================================
+
+/**
+ * Exposants des 7 dimensions de base SI :
+ * M masse (kg), L longueur (m), T temps (s), I courant (A),
+ * K température Θ (K), N quantité de matière (mol), J intensité lumineuse (cd)
+ */
+template <int M_ = 0, int L_ = 0, int T_ = 0, int I_ = 0, int K_ = 0, int N_ = 0, int J_ = 0>
+struct Dimension {
+    static constexpr int M = M_;
+    static constexpr int L = L_;
+    static constexpr int T = T_;
+    static constexpr int I = I_;
+    static constexpr int K = K_;
+    static constexpr int N = N_;
+    static constexpr int J = J_;
+};
+
+// Dimension des classes déclarées sans dimension (comportement historique, non vérifié)
+struct DimensionLibre {};
+
+template <class A, class B>
+struct ProduitDimensions {
+    typedef Dimension<A::M + B::M, A::L + B::L, A::T + B::T, A::I + B::I,
+                      A::K + B::K, A::N + B::N, A::J + B::J> type;
+};
+
+template <class A, class B>
+struct QuotientDimensions {
+    typedef Dimension<A::M - B::M, A::L - B::L, A::T - B::T, A::I - B::I,
+                      A::K - B::K, A::N - B::N, A::J - B::J> type;
+};
+
+template <class A, class B> struct MemeDimension : MemeType<A, B> {};
+
+// Dimensions usuelles         M   L   T   I   K   N   J
+typedef Dimension<>                                      DimSansDimension;
+typedef Dimension< 1>                                    DimMasse;
+typedef Dimension< 0,  1>                                DimLongueur;
+typedef Dimension< 0,  0,  1>                            DimTemps;
+typedef Dimension< 0,  0,  0,  1>                        DimCourant;
+typedef Dimension< 0,  0,  0,  0,  1>                    DimTemperature;
+typedef Dimension< 0,  0,  0,  0,  0,  1>                DimQuantiteMatiere;
+typedef Dimension< 0,  0,  0,  0,  0,  0,  1>            DimIntensiteLumineuse;
+typedef Dimension< 0,  0, -1>                            DimFrequence;
+typedef Dimension< 0,  1, -1>                            DimVitesse;
+typedef Dimension< 0,  1, -2>                            DimAcceleration;
+typedef Dimension< 1, -3>                                DimMasseVolumique;
+typedef Dimension< 1,  1, -2>                            DimForce;
+typedef Dimension< 1, -1, -2>                            DimPression;      // = densité d'énergie (J/m³)
+typedef Dimension< 1,  2, -2>                            DimEnergie;
+typedef Dimension< 1,  2, -3>                            DimPuissance;
+typedef Dimension< 1,  0, -3>                            DimDensitePuissance;
+typedef Dimension< 0,  2, -2>                            DimDoseAbsorbee;  // Gy = J/kg
+typedef Dimension< 0,  0,  1,  1>                        DimCharge;
+typedef Dimension< 1,  2, -3, -1>                        DimTension;
+typedef Dimension< 1,  2, -3, -2>                        DimResistance;
+typedef Dimension<-1, -2,  3,  2>                        DimConductance;
+typedef Dimension<-1, -2,  4,  2>                        DimCapacite;
+typedef Dimension< 1,  2, -2, -2>                        DimInductance;
+typedef Dimension< 1,  2, -2, -1>                        DimFluxMagnetique;
+typedef Dimension< 1,  0, -2, -1>                        DimChampMagnetique;
+typedef Dimension<-1, -3,  3,  2>                        DimConductivite;
+typedef Dimension< 1,  3, -3, -2>                        DimResistivite;
+typedef Dimension< 0, -2,  0,  0,  0,  0,  1>            DimEclairement;   // lx, cd/m²
+
+// ============================================================================
+// GRANDEURS TYPÉES
+// ============================================================================
+
+/**
+ * Déclare une unité : symbole en flash et facteur vers l'unité SI cohérente
+ * (ex. kWh : 3.6e6, mmHg : 133.322). Le facteur est une constante de compilation.
+ */
+#define DECLARE_UNITY_UNITE(NomUnite, UnitSymbol, Facteur) \
+struct NomUnite { \
+    /* Symbole de l'unité : une seule copie, en flash sur AVR, lue sur place */ \
+    static const __FlashStringHelper* symbole() { \
+        static const char texte[] PROGMEM = UnitSymbol; \
+        return reinterpret_cast<const __FlashStringHelper*>(texte); \
+    } \
+    /* Le même, pour les calculs à la compilation (rien n'est émis) */ \
+    static constexpr const char* texte() { return UnitSymbol; } \
+    static constexpr float facteur() { return Facteur; } \
+};
+
+// Unité SI cohérente sans symbole déclaré (résultat d'un produit ou d'un quotient)
+DECLARE_UNITY_UNITE(UniteSI, "", 1.0f)
+
+/**
+ * Partie commune à toutes les grandeurs : valeur (de type T) et affichage
+ * avec le symbole de U
+ */
+template <class U, class T = float>
+class GrandeurBase : public C_UNITY_T<T> {
+public:
+    typedef U Unite;
+
+    GrandeurBase() : C_UNITY_T<T>() {}
+    GrandeurBase(T val) : C_UNITY_T<T>(val) {}
+
+    static const __FlashStringHelper* symbole() { return U::symbole(); }
+
+    String afficher(int nbDecimal = 3) const {
+        UNITY_CHRONO(AFFICHER);
+        return this->valeurAvecUnite(symbole(), nbDecimal);
+    }
+
+    static String afficher(T val, int nbDecimal = 3) {
+        UNITY_CHRONO(AFFICHER);
+        return C_UNITY_BASE::valeurAvecUnite(val, symbole(), nbDecimal);
+    }
+
+    // Versions sans allocation : écrivent dans le tampon de l'appelant
+    size_t afficher(char* out, size_t cap, int nbDecimal = 3) const {
+        UNITY_CHRONO(AFFICHER);
+        return this->valeurAvecUnite(out, cap, symbole(), nbDecimal);
+    }
+
+    static size_t afficher(char* out, size_t cap, T val, int nbDecimal = 3) {
+        UNITY_CHRONO(AFFICHER);
+        return C_UNITY_BASE::valeurAvecUnite(out, cap, val, symbole(), nbDecimal);
+    }
+
+    static size_t afficher(char* out, size_t cap, const T* vals, size_t n, char separateur = ';', int nbDecimal = 3) {
+        UNITY_CHRONO(AFFICHER);
+        return C_UNITY_BASE::valeursAvecUnite(out, cap, vals, n, symbole(), separateur, nbDecimal);
+    }
+
+    // Versions sans String : écrivent directement dans une sortie (Serial...)
+    size_t afficher(Print& sortie, int nbDecimal = 3) const {
+        UNITY_CHRONO(AFFICHER);
+        return this->valeurAvecUnite(sortie, symbole(), nbDecimal);
+    }
+
+    static size_t afficher(Print& sortie, T val, int nbDecimal = 3) {
+        UNITY_CHRONO(AFFICHER);
+        return C_UNITY_BASE::valeurAvecUnite(sortie, val, symbole(), nbDecimal);
+    }
+
+    static size_t afficher(Print& sortie, const T* vals, size_t n, char separateur = ';', int nbDecimal = 3) {
+        UNITY_CHRONO(AFFICHER);
+        return C_UNITY_BASE::valeursAvecUnite(sortie, vals, n, symbole(), separateur, nbDecimal);
+    }
+
+    /**
+     * Inverse de afficher : "4.7kΩ", "4.700 kΩ" ou "4700" pour une Resistance.
+     * Sans allocation ; la valeur n'est modifiée que si la lecture réussit.
+     */
+    bool lire(const char* texte) {
+        return lire(texte, texte + strlen(texte), this->valeur);
+    }
+
+    static bool lire(const char* texte, T& val) {
+        return lire(texte, texte + strlen(texte), val);
+    }
+
+    // Texte non terminé (trame, ligne de commande) : [debut, fin[
+    static bool lire(const char* debut, const char* fin, T& val) {
+        typename ScalaireUnity<T>::Constante lu;
+        if (!C_UNITY_BASE::lireAvecUnite(debut, fin, symbole(), lu)) return false;
+        val = T(lu);
+        return true;
+    }
+};
+
+template <class D, class U, class T = float> class Grandeur;
+template <class Vers, class De> struct ConversionUnity;
+
+/**
+ * Type résultat d'un produit ou d'un quotient de dimension D.
+ * Spécialisé par DECLARE_UNITY_CANONIQUE (ex. DimTension -> Tension).
+ */
+template <class D>
+struct GrandeurSI {
+    typedef Grandeur<D, UniteSI> type;
+};
+
+/**
+ * G avec la représentation T (G elle-même si elle l'utilise déjà)
+ */
+template <class G, class T, bool = MemeType<typename G::Scalaire, T>::valeur>
+struct ChangerScalaire {
+    typedef Grandeur<typename G::Dim, typename G::Unite, T> type;
+};
+
+template <class G, class T>
+struct ChangerScalaire<G, T, true> {
+    typedef G type;
+};
+
+// Type résultat de dimension D pour des opérandes de représentation T
+template <class D, class T>
+struct ResultatSI {
+    typedef typename ChangerScalaire<typename GrandeurSI<D>::type, T>::type type;
+};
+
+/**
+ * Même grandeur dans une autre représentation :
+ *   GrandeurEn<Tension, double> total;
+ *   GrandeurEn<Courant, VirguleFixe<16> > i;
+ */
+template <class G, class T>
+using GrandeurEn = Grandeur<typename G::Dim, typename G::Unite, T>;
+
+/**
+ * Grandeur physique de dimension D exprimée dans l'unité U, valeur de type T.
+ * Ne contient que la valeur : les dimensions n'existent qu'à la compilation,
+ * le code généré est celui du calcul sur T (les facteurs d'unité valant 1
+ * disparaissent à l'optimisation). Les opérandes d'une même opération
+ * partagent la même représentation T.
+ *
+ *   Tension v = r * i;      // Resistance * Courant -> Tension
+ *   Puissance p = v * i;    // Tension * Courant -> Puissance
+ *   v + i;                  // Erreur de compilation : dimensions différentes
+ */
+template <class D, class U, class T>
+class Grandeur : public GrandeurBase<U, T> {
+    typedef GrandeurBase<U, T> Base;
+
+public:
+    typedef D Dim;
+
+    Grandeur() : Base() {}
+    Grandeur(T val) : Base(val) {}
+
+    // Conversion entre unités de même dimension (ex. EnergieKWh -> Energie)
+    template <class U2>
+    Grandeur(const Grandeur<D, U2, T>& autre) : Base(multiplier(autre.getValeur(), rapport<U2>())) {}
+
+    // Addition et soustraction : mêmes dimensions obligatoires
+    template <class D2, class U2>
+    Grandeur operator+(const Grandeur<D2, U2, T>& autre) const {
+        static_assert(MemeDimension<D, D2>::valeur, "Addition de grandeurs de dimensions differentes");
+        return Grandeur(this->valeur + multiplier(autre.getValeur(), rapport<U2>()));
+    }
+
+    template <class D2, class U2>
+    Grandeur operator-(const Grandeur<D2, U2, T>& autre) const {
+        static_assert(MemeDimension<D, D2>::valeur, "Soustraction de grandeurs de dimensions differentes");
+        return Grandeur(this->valeur - multiplier(autre.getValeur(), rapport<U2>()));
+    }
+
+    template <class D2, class U2>
+    Grandeur& operator+=(const Grandeur<D2, U2, T>& autre) {
+        static_assert(MemeDimension<D, D2>::valeur, "Addition de grandeurs de dimensions differentes");
+        this->valeur += multiplier(autre.getValeur(), rapport<U2>());
+        return *this;
+    }
+
+    template <class D2, class U2>
+    Grandeur& operator-=(const Grandeur<D2, U2, T>& autre) {
+        static_assert(MemeDimension<D, D2>::valeur, "Soustraction de grandeurs de dimensions differentes");
+        this->valeur -= multiplier(autre.getValeur(), rapport<U2>());
+        return *this;
+    }
+
+    // Produit et quotient : les dimensions s'additionnent / se soustraient,
+    // le résultat est exprimé en unité SI cohérente
+    template <class D2, class U2>
+    typename ResultatSI<typename ProduitDimensions<D, D2>::type, T>::type
+    operator*(const Grandeur<D2, U2, T>& autre) const {
+        constexpr float k = U::facteur() * U2::facteur();
+        return typename ResultatSI<typename ProduitDimensions<D, D2>::type, T>::type(multiplier(this->valeur * autre.getValeur(), k));
+    }
+
+    template <class D2, class U2>
+    typename ResultatSI<typename QuotientDimensions<D, D2>::type, T>::type
+    operator/(const Grandeur<D2, U2, T>& autre) const {
+        constexpr float k = U::facteur() / U2::facteur();
+        return typename ResultatSI<typename QuotientDimensions<D, D2>::type, T>::type(multiplier(this->valeur / autre.getValeur(), k));
+    }
+
+    // Mise à l'échelle par un scalaire (gabarits : v * 2 n'est pas ambigu avec float * int)
+    template <class S>
+    typename ActiverSi<EstScalaire<S>::valeur, Grandeur>::type operator*(S scalaire) const {
+        return Grandeur(this->valeur * (T)scalaire);
+    }
+
+    template <class S>
+    typename ActiverSi<EstScalaire<S>::valeur, Grandeur>::type operator/(S scalaire) const {
+        return Grandeur(this->valeur / (T)scalaire);
+    }
+
+    template <class S>
+    friend typename ActiverSi<EstScalaire<S>::valeur, Grandeur>::type operator*(S scalaire, const Grandeur& g) {
+        return Grandeur((T)scalaire * g.valeur);
+    }
+
+    Grandeur& operator*=(T scalaire) { this->valeur *= scalaire; return *this; }
+    Grandeur& operator/=(T scalaire) { this->valeur /= scalaire; return *this; }
+
+    // Comparaisons : mêmes dimensions obligatoires, les deux valeurs sont
+    // exprimées dans la plus petite des deux unités (facteur >= 1, exact pour
+    // 1 kWh == 3.6e6 J) : EnergieKWh(1) < Energie(1000) est faux
+    template <class D2, class U2>
+    bool operator==(const Grandeur<D2, U2, T>& autre) const { return commune(*this, autre) == commune(autre, *this); }
+
+    template <class D2, class U2>
+    bool operator!=(const Grandeur<D2, U2, T>& autre) const { return commune(*this, autre) != commune(autre, *this); }
+
+    template <class D2, class U2>
+    bool operator<(const Grandeur<D2, U2, T>& autre) const { return commune(*this, autre) < commune(autre, *this); }
+
+    template <class D2, class U2>
+    bool operator<=(const Grandeur<D2, U2, T>& autre) const { return commune(*this, autre) <= commune(autre, *this); }
+
+    template <class D2, class U2>
+    bool operator>(const Grandeur<D2, U2, T>& autre) const { return commune(*this, autre) > commune(autre, *this); }
+
+    template <class D2, class U2>
+    bool operator>=(const Grandeur<D2, U2, T>& autre) const { return commune(*this, autre) >= commune(autre, *this); }
+
+    // Comparaison avec un scalaire ou un C_UNITY_T : inchangée
+    using Base::operator==;
+    using Base::operator!=;
+    using Base::operator<;
+    using Base::operator<=;
+    using Base::operator>;
+    using Base::operator>=;
+
+private:
+    // Valeur de a dans la plus petite des unités de a et b (ConversionUnity)
+    template <class Da, class Ua, class Db, class Ub>
+    static T commune(const Grandeur<Da, Ua, T>& a, const Grandeur<Db, Ub, T>&) {
+        static_assert(MemeDimension<Da, Db>::valeur, "Comparaison de grandeurs de dimensions differentes");
+        typedef Grandeur<Da, Ua, T> A;
+        typedef Grandeur<Db, Ub, T> B;
+        return Ua::facteur() > Ub::facteur() ? ConversionUnity<B, A>::appliquer(a.getValeur()) : a.getValeur();
+    }
+
+    // Facteur de U2 vers U, évalué à la compilation
+    template <class U2>
+    static constexpr float rapport() { return U2::facteur() / U::facteur(); }
+
+    // Facteur d'unité constant : rien n'est émis quand il vaut 1
+    static T multiplier(T val, float k) { return k == 1.0f ? val : val * T(k); }
+};
+
+/**
+ * Classes déclarées sans dimension : opérations entre objets de même type
+ * uniquement, comme avant l'introduction des dimensions
+ */
+template <class U, class T>
+class Grandeur<DimensionLibre, U, T> : public GrandeurBase<U, T> {
+    typedef GrandeurBase<U, T> Base;
+
+public:
+    typedef DimensionLibre Dim;
+
+    Grandeur() : Base() {}
+    Grandeur(T val) : Base(val) {}
+
+    Grandeur operator+(const Grandeur& other) const { return Grandeur(this->valeur + other.valeur); }
+    Grandeur operator-(const Grandeur& other) const { return Grandeur(this->valeur - other.valeur); }
+    Grandeur operator*(const Grandeur& other) const { return Grandeur(this->valeur * other.valeur); }
+    Grandeur operator/(const Grandeur& other) const { return Grandeur(this->valeur / other.valeur); }
+};
+
+// ============================================================================
+// CONVERSIONS ENTRE UNITÉS (FACTEUR CALCULÉ À LA COMPILATION)
+// ============================================================================
+
+/**
+ * Conversion de la classe De vers la classe Vers, de même dimension :
+ * facteur = facteur(De) / facteur(Vers), calculé en double à la compilation
+ * puis arrondi une fois. Aller de mmHg vers hPa ne passe pas par le pascal
+ * à l'exécution : une seule multiplication, aucune si le facteur vaut 1.
+ * Unités de dimensions différentes, ou classe déclarée sans dimension :
+ * erreur de compilation.
+ */
+template <class Vers, class De>
+struct ConversionUnity {
+    static_assert(!MemeType<typename De::Dim, DimensionLibre>::valeur && !MemeType<typename Vers::Dim, DimensionLibre>::valeur,
+                  "Conversion d'une classe declaree sans dimension");
+    static_assert(MemeDimension<typename De::Dim, typename Vers::Dim>::valeur,
+                  "Conversion entre unites de dimensions differentes");
+
+    typedef typename Vers::Scalaire T;
+    typedef typename ScalaireUnity<T>::Constante Constante;
+
+    static constexpr Constante facteur() {
+        return (Constante)((double)De::Unite::facteur() / (double)Vers::Unite::facteur());
+    }
+
+    static T appliquer(typename De::Scalaire val) {
+        return facteur() == Constante(1) ? T(val) : T(val) * T(facteur());
+    }
+};
+
+/**
+ *   ChampMagnetique b = convertir<ChampMagnetique>(ChampMagnetique_Gauss(1200)); // 0.12 T
+ *   Pression p = convertir<Pression>(Pression_mmHg(760));                       // 101325 Pa
+ */
+template <class Vers, class De>
+Vers convertir(const De& g) {
+    return Vers(ConversionUnity<Vers, De>::appliquer(g.getValeur()));
+}
+
+/**
+ * Tableau de valeurs (de et vers peuvent être le même tableau) : une
+ * multiplication par élément par une constante, boucle que le compilateur
+ * vectorise sur les processeurs qui le permettent
+ *   convertir<Pression, Pression_mmHg>(mesures, pascals, n);
+ */
+template <class Vers, class De>
+void convertir(const typename De::Scalaire* de, typename Vers::Scalaire* vers, size_t n) {
+    for (size_t i = 0; i < n; i++) vers[i] = ConversionUnity<Vers, De>::appliquer(de[i]);
+}
+
+// ============================================================================
+// MACRO POUR CRÉER DES CLASSES D'UNITÉS (RÉDUIT LE CODE RÉPÉTITIF)
+// ============================================================================
+
+/**
+ * DECLARE_UNITY_CLASS(Nom, "symbole")                   sans dimension (historique)
+ * DECLARE_UNITY_CLASS(Nom, "symbole", Dim)              unité SI cohérente
+ * DECLARE_UNITY_CLASS(Nom, "symbole", Dim, facteur)     unité valant facteur × unité SI
+ *
+ * Nom devient un alias de Grandeur<Dim, Nom_Unite>.
+ */
+#define DECLARE_UNITY_CLASS_2(ClassName, UnitSymbol) \
+    DECLARE_UNITY_UNITE(ClassName##_Unite, UnitSymbol, 1.0f) \
+    typedef Grandeur<DimensionLibre, ClassName##_Unite> ClassName;
+
+#define DECLARE_UNITY_CLASS_3(ClassName, UnitSymbol, Dim) \
+    DECLARE_UNITY_UNITE(ClassName##_Unite, UnitSymbol, 1.0f) \
+    typedef Grandeur<Dim, ClassName##_Unite> ClassName;
+
+#define DECLARE_UNITY_CLASS_4(ClassName, UnitSymbol, Dim, Facteur) \
+    DECLARE_UNITY_UNITE(ClassName##_Unite, UnitSymbol, Facteur) \
+    typedef Grandeur<Dim, ClassName##_Unite> ClassName;
+
+#define UNITY_CHOIX_MACRO(_1, _2, _3, _4, NOM, ...) NOM
+#define DECLARE_UNITY_CLASS(...) \
+    UNITY_CHOIX_MACRO(__VA_ARGS__, DECLARE_UNITY_CLASS_4, DECLARE_UNITY_CLASS_3, DECLARE_UNITY_CLASS_2, )(__VA_ARGS__)
+
+/**
+ * Fait de ClassName le type résultat des produits/quotients de sa dimension
+ * (une seule classe canonique par dimension)
+ */
+#define DECLARE_UNITY_CANONIQUE(ClassName) \
+    template <> struct GrandeurSI<ClassName::Dim> { typedef ClassName type; };
+
+
+// ============================================================================
+// RÉPERTOIRE DES UNITÉS (IDENTIFIANT, SYMBOLE, DIMENSION, FACTEUR)
+// ============================================================================
+
+/**
+ * Exposants des 7 dimensions de base d'une unité, à l'exécution (ailleurs,
+ * la dimension n'existe que dans le type). M vaut LIBRE pour une classe
+ * déclarée sans dimension.
+ */
+struct DimensionsSI {
+    static constexpr int8_t LIBRE = -128;
+
+    int8_t M, L, T, I, K, N, J;
+
+    bool libre() const { return M == LIBRE; }
+
+    bool operator==(const DimensionsSI& d) const {
+        return M == d.M && L == d.L && T == d.T && I == d.I && K == d.K && N == d.N && J == d.J;
+    }
+    bool operator!=(const DimensionsSI& d) const { return !(*this == d); }
+};
+
+template <class D>
+struct ExposantsSI {
+    static constexpr DimensionsSI valeur() {
+        return DimensionsSI{ (int8_t)D::M, (int8_t)D::L, (int8_t)D::T, (int8_t)D::I,
+                             (int8_t)D::K, (int8_t)D::N, (int8_t)D::J };
+    }
+};
+
+template <>
+struct ExposantsSI<DimensionLibre> {
+    static constexpr DimensionsSI valeur() { return DimensionsSI{ DimensionsSI::LIBRE, 0, 0, 0, 0, 0, 0 }; }
+};
+
+/**
+ * Répertoire d'un ensemble de classes, calculé à la compilation et rangé en
+ * flash (aucun octet de RAM) :
+ * - identifiant -> symbole, facteur, dimension : lecture directe à l'indice ;
+ * - symbole -> identifiant : hachage parfait à deux niveaux. L'empreinte
+ *   djb2 désigne une alvéole (trois symboles au plus) dont la graine,
+ *   cherchée à la compilation, donne à chacun de ses symboles une case
+ *   distincte : une seule comparaison de chaîne par recherche. La table a
+ *   au moins deux alvéoles par classe ; une alvéole qui reçoit plus de
+ *   trois symboles, ou dont aucune graine ne les sépare, est marquée
+ *   débordée et ses recherches parcourent la liste (cas rare, toujours
+ *   juste).
+ * Un symbole déclaré plusieurs fois ("V", "%", "°C") désigne la première
+ * classe de la liste.
+ *
+ * R est le répertoire déclaré par DECLARE_UNITY_REPERTOIRE
+ * (R::NB_ENTREES et R::texte(i) constexpr).
+ */
+struct RepertoireUnity {
+    static constexpr uint8_t TAILLE_SYMBOLE = 8;   // Octets, '\0' compris ("µg/m³" en occupe 8)
+    static constexpr uint8_t TAILLE_ALVEOLE = 3;   // Symboles par alvéole au plus
+    static constexpr uint8_t NB_GRAINES = 64;      // Graine sur 6 bits
+    static constexpr uint8_t FIN = 0xFF;           // Case vide / graine introuvable
+    static constexpr uint8_t DEBORDEE = 0xFC;      // Code d'une alvéole parcourue (graine 63, aucun symbole)
+    static constexpr uint8_t AUCUNE = 0;           // Identifiant d'un nombre sans symbole
+
+    // Alvéoles pour n entrées : puissance de 2 >= 2n (8 au moins, 512 pour 255 entrées)
+    static constexpr uint16_t nbAlveoles(size_t n, uint16_t a = 8) {
+        return a >= 2 * n ? a : nbAlveoles(n, (uint16_t)(a * 2));
+    }
+
+    struct Entree {
+        char texte[TAILLE_SYMBOLE];
+    };
+
+    // Facteur vers l'unité SI cohérente (kWh : 3.6e6) et dimension
+    struct Fiche {
+        float facteur;
+        DimensionsSI dimension;
+    };
+
+    // Graine (6 bits hauts) et nombre de symboles (2 bits bas), puis
+    // l'identifiant rangé dans chaque case
+    struct Alveole {
+        uint8_t code;
+        uint8_t ids[TAILLE_ALVEOLE];
+    };
+
+    // Empreinte djb2 (×33, ou exclusif) sur 16 bits, repliée sur les nb alvéoles
+    static uint16_t alveole(const char* s, size_t n, uint16_t nb) {
+        uint16_t h = 5381;
+        for (size_t k = 0; k < n; k++) h = (uint16_t)(h * 33u) ^ (uint8_t)s[k];
+        return replierAlveole(h, nb);
+    }
+
+    // Case du symbole dans une alvéole de nombre symboles (FNV-1a 16 bits, base selon la graine)
+    static uint8_t casePour(const char* s, size_t n, uint8_t graine, uint8_t nombre) {
+        uint16_t h = (uint16_t)(0x811Cu ^ (graine * 0x9E37u));
+        for (size_t k = 0; k < n; k++) h = (uint16_t)((uint16_t)(h ^ (uint8_t)s[k]) * 0x0193u);
+        return (uint8_t)((uint16_t)(h ^ (h >> 8)) % nombre);
+    }
+
+    // --- Versions constexpr (C++11 : récursion plutôt que boucles) ---
+
+    static constexpr uint16_t empreinteC(const char* s, uint16_t h = 5381) {
+        return *s == '\0' ? h : empreinteC(s + 1, (uint16_t)((uint16_t)(h * 33u) ^ (uint8_t)*s));
+    }
+
+    static constexpr uint16_t replierAlveole(uint16_t h, uint16_t nb) {
+        return (uint16_t)((h ^ (h >> 7)) & (nb - 1));
+    }
+
+    static constexpr uint16_t alveoleC(const char* s, uint16_t nb) {
+        return replierAlveole(empreinteC(s), nb);
+    }
+
+    static constexpr uint16_t melangeC(const char* s, uint16_t h) {
+        return *s == '\0' ? h : melangeC(s + 1, (uint16_t)((uint16_t)(h ^ (uint8_t)*s) * 0x0193u));
+    }
+
+    static constexpr uint8_t replierC(uint16_t h, uint8_t nombre) {
+        return (uint8_t)((uint16_t)(h ^ (h >> 8)) % nombre);
+    }
+
+    static constexpr uint8_t caseC(const char* s, uint8_t graine, uint8_t nombre) {
+        return replierC(melangeC(s, (uint16_t)(0x811Cu ^ (graine * 0x9E37u))), nombre);
+    }
+
+    static constexpr size_t longueurC(const char* s) {
+        return *s == '\0' ? 0 : 1 + longueurC(s + 1);
+    }
+
+    static constexpr char caractereC(const char* s, int k) {
+        return *s == '\0' ? '\0' : k == 0 ? *s : caractereC(s + 1, k - 1);
+    }
+
+    static constexpr bool egauxC(const char* a, const char* b) {
+        return *a == *b && (*a == '\0' || egauxC(a + 1, b + 1));
+    }
+
+    // Le symbole de l'entrée i figure-t-il déjà plus haut (j < i) ?
+    template <class R>
+    static constexpr bool dejaVu(int i, int j = 1) {
+        return j < i && (egauxC(R::texte(j), R::texte(i)) || dejaVu<R>(i, j + 1));
+    }
+
+    // Entrée i présente dans la table de hachage (symbole non vide, première occurrence)
+    template <class R>
+    static constexpr bool rangee(int i) {
+        return R::texte(i)[0] != '\0' && !dejaVu<R>(i);
+    }
+
+    // Première entrée rangée dans l'alvéole a à partir de i (FIN s'il n'y en a pas)
+    template <class R>
+    static constexpr uint8_t suivant(uint16_t a, int i) {
+        return i >= R::NB_ENTREES ? FIN
+             : alveoleC(R::texte(i), R::NB_ALVEOLES) == a && rangee<R>(i) ? (uint8_t)i
+             : suivant<R>(a, i + 1);
+    }
+
+    template <class R>
+    static constexpr uint8_t apres(uint16_t a, uint8_t m) {
+        return m == FIN ? FIN : suivant<R>(a, m + 1);
+    }
+
+    // La graine g donne-t-elle des cases distinctes aux n membres m0, m1, m2 ?
+    template <class R>
+    static constexpr bool separe(uint8_t g, uint8_t n, uint8_t m0, uint8_t m1, uint8_t m2) {
+        return n < 2 || (caseC(R::texte(m0), g, n) != caseC(R::texte(m1), g, n) &&
+               (n < 3 || (caseC(R::texte(m2), g, n) != caseC(R::texte(m0), g, n) &&
+                          caseC(R::texte(m2), g, n) != caseC(R::texte(m1), g, n))));
+    }
+
+    template <class R>
+    static constexpr uint8_t graine(uint8_t n, uint8_t m0, uint8_t m1, uint8_t m2, uint8_t g = 0) {
+        return g >= NB_GRAINES ? FIN : separe<R>(g, n, m0, m1, m2) ? g : graine<R>(n, m0, m1, m2, g + 1);
+    }
+
+    // Membre rangé dans la case k
+    template <class R>
+    static constexpr uint8_t occupant(uint8_t k, uint8_t g, uint8_t n, uint8_t m0, uint8_t m1, uint8_t m2) {
+        return n > 0 && caseC(R::texte(m0), g, n) == k ? m0
+             : n > 1 && caseC(R::texte(m1), g, n) == k ? m1
+             : n > 2 && caseC(R::texte(m2), g, n) == k ? m2 : FIN;
+    }
+
+    // Plus de TAILLE_ALVEOLE symboles, ou aucune graine ne les sépare : alvéole débordée
+    template <class R>
+    static constexpr Alveole ranger(uint8_t g, uint8_t n, uint8_t m0, uint8_t m1, uint8_t m2, uint8_t m3) {
+        return m3 != FIN || g == FIN ? Alveole{ DEBORDEE, { FIN, FIN, FIN } }
+             : Alveole{ (uint8_t)((g << 2) | n),
+                        { occupant<R>(0, g, n, m0, m1, m2), occupant<R>(1, g, n, m0, m1, m2),
+                          occupant<R>(2, g, n, m0, m1, m2) } };
+    }
+
+    template <class R>
+    static constexpr Alveole ranger(uint8_t n, uint8_t m0, uint8_t m1, uint8_t m2, uint8_t m3) {
+        return ranger<R>(graine<R>(n, m0, m1, m2), n, m0, m1, m2, m3);
+    }
+
+    // Membres de l'alvéole a en une seule passe sur les entrées
+    template <class R>
+    static constexpr Alveole alveoleDe(uint16_t a, uint8_t m0, uint8_t m1, uint8_t m2) {
+        return ranger<R>((uint8_t)((m0 != FIN) + (m1 != FIN) + (m2 != FIN)), m0, m1, m2, apres<R>(a, m2));
+    }
+
+    template <class R>
+    static constexpr Alveole alveoleDe(uint16_t a, uint8_t m0, uint8_t m1) {
+        return alveoleDe<R>(a, m0, m1, apres<R>(a, m1));
+    }
+
+    template <class R>
+    static constexpr Alveole alveoleDe(uint16_t a, uint8_t m0) {
+        return alveoleDe<R>(a, m0, apres<R>(a, m0));
+    }
+
+    template <class R>
+    static constexpr Alveole alveoleDe(uint16_t a) {
+        return alveoleDe<R>(a, suivant<R>(a, 1));
+    }
+
+    // Indices 0..N-1 d'une table calculée (pas de std::index_sequence en C++11 sur AVR)
+    template <uint16_t... I> struct Indices {};
+    template <uint16_t N, uint16_t... I> struct SuiteIndices : SuiteIndices<N - 1, N - 1, I...> {};
+    template <uint16_t... I> struct SuiteIndices<0, I...> { typedef Indices<I...> Type; };
+
+    // Table des R::NB_ALVEOLES alvéoles, en flash
+    template <class R, class S = typename SuiteIndices<R::NB_ALVEOLES>::Type> struct TableAlveoles;
+
+    template <class R, uint16_t... I>
+    struct TableAlveoles<R, Indices<I...> > {
+        static const Alveole* table() {
+            static constexpr Alveole a[sizeof...(I)] PROGMEM = { alveoleDe<R>(I)... };
+            return a;
+        }
+    };
+
+    template <class R>
+    static constexpr Entree entree(int i) {
+        return Entree{ { caractereC(R::texte(i), 0), caractereC(R::texte(i), 1),
+                         caractereC(R::texte(i), 2), caractereC(R::texte(i), 3),
+                         caractereC(R::texte(i), 4), caractereC(R::texte(i), 5),
+                         caractereC(R::texte(i), 6), caractereC(R::texte(i), 7) } };
+    }
+
+    template <class G>
+    static constexpr Fiche ficheDe() {
+        return Fiche{ G::Unite::facteur(), ExposantsSI<typename G::Dim>::valeur() };
+    }
+
+    // Fiche de l'identifiant AUCUNE : nombre sans unité
+    static constexpr Fiche ficheNombre() {
+        return Fiche{ 1.0f, ExposantsSI<DimSansDimension>::valeur() };
+    }
+
+    template <class R>
+    static constexpr bool symbolesCourts(int i = 1) {
+        return i >= R::NB_ENTREES || (longueurC(R::texte(i)) < TAILLE_SYMBOLE && symbolesCourts<R>(i + 1));
+    }
+
+    // --- Exécution ---
+
+    /**
+     * Identifiant de la classe de symbole [s, s + n[, AUCUNE s'il est vide
+     * ou inconnu. Deux empreintes, une seule comparaison (parcours de la
+     * liste pour une alvéole débordée).
+     */
+    template <class R>
+    static uint8_t chercher(const char* s, size_t n) {
+        if (n == 0 || n >= TAILLE_SYMBOLE) return AUCUNE;
+        const Alveole* a = &R::alveoles()[alveole(s, n, R::NB_ALVEOLES)];
+        uint8_t code = pgm_read_byte(&a->code);
+        uint8_t nb = code & 0x03;
+        if (code == DEBORDEE) {
+            for (uint8_t i = 1; i < R::NB_ENTREES; i++) {
+                if (egal(R::table()[i].texte, s, n)) return i;
+            }
+            return AUCUNE;
+        }
+        if (nb == 0) return AUCUNE;
+        uint8_t i = pgm_read_byte(&a->ids[nb == 1 ? 0 : casePour(s, n, code >> 2, nb)]);
+        return egal(R::table()[i].texte, s, n) ? i : AUCUNE;
+    }
+
+    // Symbole en flash égal à [s, s + n[ ?
+    static bool egal(const char* texte, const char* s, size_t n) {
+        size_t k = 0;
+        while (k < n && (char)pgm_read_byte(texte + k) == s[k]) k++;
+        return k == n && pgm_read_byte(texte + n) == '\0';
+    }
+
+    // Fiche lue en flash
+    static Fiche lireFiche(const Fiche* f) {
+        Fiche copie;
+        const uint8_t* source = reinterpret_cast<const uint8_t*>(f);
+        uint8_t* cible = reinterpret_cast<uint8_t*>(&copie);
+        for (size_t k = 0; k < sizeof(Fiche); k++) cible[k] = pgm_read_byte(source + k);
+        return copie;
+    }
+
+    /**
+     * Lit "4.7kΩ", "100 nF", "2.4GHz" : valeur (préfixe appliqué) et
+     * identifiant de la classe du symbole (AUCUNE pour un nombre seul).
+     * Le symbole exact passe avant le préfixe : "ms" est DureeCrete, "mA"
+     * est milli-Courant, "T" est le tesla et "4k" un nombre sans unité.
+     */
+    template <class R, class V>
+    static bool lire(const char* debut, const char* fin, V& valeur, uint8_t& unite) {
+        C_UNITY_BASE::NombreLu n;
+        const char* p = C_UNITY_BASE::lireNombre(C_UNITY_BASE::sauterEspaces(debut, fin), fin, n);
+        if (!p) return false;
+        p = C_UNITY_BASE::sauterEspaces(p, fin);
+        fin = C_UNITY_BASE::finSansEspaces(p, fin);
+
+        uint8_t id = chercher<R>(p, (size_t)(fin - p));
+        if (id != AUCUNE || p == fin) {
+            if (!C_UNITY_BASE::valeurLue(n, n.exposant, valeur)) return false;
+            unite = id;
+            return true;
+        }
+
+        int indice;
+        uint8_t lus = C_UNITY_BASE::lirePrefixe(p, fin, indice);
+        if (!lus) return false;
+        id = chercher<R>(p + lus, (size_t)(fin - p - lus));
+        if (id == AUCUNE && p + lus != fin) return false;
+        if (!C_UNITY_BASE::valeurLue(n, n.exposant + 3 * (indice - C_UNITY_BASE::INDICE_UNITE), valeur)) return false;
+        unite = id;
+        return true;
+    }
+};
+
+#define UNITY_REPERTOIRE_ID(Classe) ID_##Classe,
+#define UNITY_REPERTOIRE_TEXTE(Classe) i == ID_##Classe ? Classe::Unite::texte() :
+#define UNITY_REPERTOIRE_FICHE_DE(Classe) i == ID_##Classe ? RepertoireUnity::ficheDe<Classe>() :
+#define UNITY_REPERTOIRE_ENTREE(Classe) RepertoireUnity::entree<Repertoire>(ID_##Classe),
+#define UNITY_REPERTOIRE_FICHE(Classe) RepertoireUnity::ficheDe<Classe>(),
+#define UNITY_REPERTOIRE_ID_DE(Classe) static constexpr uint8_t idDe(const Classe::Unite*) { return ID_##Classe; }
+
+/**
+ * Déclare le répertoire Nom des classes énumérées par Liste, une X-macro :
+ *   #define MES_UNITES(X) X(Tension) X(Courant) X(Resistance)
+ *   DECLARE_UNITY_REPERTOIRE(MesUnites, MES_UNITES)
+ *
+ *   float v; uint8_t id;
+ *   if (MesUnites::lire("4.7kΩ", v, id) && id == MesUnites::ID_Resistance) ...
+ *   MesUnites::facteur(id);     // Vers l'unité SI cohérente
+ *   MesUnites::dimension(id);   // DimensionsSI
+ *
+ * Les identifiants suivent l'ordre de la liste (1, 2, ...) : n'ajouter
+ * qu'en fin de liste si des identifiants sont conservés (EEPROM, trames).
+ * MesUnites::identifiant<Tension>() donne l'identifiant d'une classe à la
+ * compilation (erreur de compilation si elle n'est pas dans la liste), et
+ * texte(i) et fiche(i) son symbole et sa fiche, constexpr.
+ * Toute classe ayant Unite (DECLARE_UNITY_UNITE) et Dim peut figurer dans
+ * la liste. Les tables ne sont émises que si elles servent.
+ */
+#define DECLARE_UNITY_REPERTOIRE(Nom, Liste) \
+struct Nom { \
+    typedef Nom Repertoire; \
+    enum : uint8_t { AUCUNE = RepertoireUnity::AUCUNE, Liste(UNITY_REPERTOIRE_ID) NB_ENTREES }; \
+    static_assert(NB_ENTREES < RepertoireUnity::FIN, "Repertoire : 254 classes au plus"); \
+    enum : uint16_t { NB_ALVEOLES = RepertoireUnity::nbAlveoles(NB_ENTREES) }; \
+    static constexpr const char* texte(int i) { return Liste(UNITY_REPERTOIRE_TEXTE) ""; } \
+    static constexpr RepertoireUnity::Fiche fiche(int i) { \
+        return Liste(UNITY_REPERTOIRE_FICHE_DE) RepertoireUnity::ficheNombre(); \
     } \
-    static String afficher(float val, int nbDecimal = 3) { \
-        return C_UNITY::valeurAvecUnite(val, UnitSymbol, nbDecimal); \
+    static const RepertoireUnity::Entree* table() { \
+        static_assert(RepertoireUnity::symbolesCourts<Repertoire>(), "Repertoire : symbole de plus de 7 octets"); \
+        static constexpr RepertoireUnity::Entree t[] PROGMEM = { \
+            RepertoireUnity::entree<Repertoire>(AUCUNE), Liste(UNITY_REPERTOIRE_ENTREE) }; \
+        return t; \
     } \
-    /* Pour faciliter les opérations entre objets de même type */ \
-    ClassName operator+(const ClassName& other) const { \
-        return ClassName(valeur + other.valeur); \
+    static const RepertoireUnity::Alveole* alveoles() { return RepertoireUnity::TableAlveoles<Repertoire>::table(); } \
+    static const RepertoireUnity::Fiche* fiches() { \
+        static constexpr RepertoireUnity::Fiche f[] PROGMEM = { \
+            RepertoireUnity::ficheNombre(), Liste(UNITY_REPERTOIRE_FICHE) }; \
+        return f; \
     } \
-    ClassName operator-(const ClassName& other) const { \
-        return ClassName(valeur - other.valeur); \
+    Liste(UNITY_REPERTOIRE_ID_DE) \
+    template <class G> \
+    static constexpr uint8_t identifiant() { return idDe(static_cast<const typename G::Unite*>(nullptr)); } \
+    static uint8_t chercher(const char* s, size_t n) { return RepertoireUnity::chercher<Repertoire>(s, n); } \
+    static bool lire(const char* s, float& valeur, uint8_t& unite) { \
+        return RepertoireUnity::lire<Repertoire>(s, s + strlen(s), valeur, unite); \
     } \
-    ClassName operator*(const ClassName& other) const { \
-        return ClassName(valeur * other.valeur); \
+    template <class V> \
+    static bool lire(const char* debut, const char* fin, V& valeur, uint8_t& unite) { \
+        return RepertoireUnity::lire<Repertoire>(debut, fin, valeur, unite); \
     } \
-    ClassName operator/(const ClassName& other) const { \
-        return ClassName(valeur / other.valeur); \
+    /* Symbole (en flash), facteur et dimension de l'identifiant id (AUCUNE s'il est inconnu) */ \
+    static const __FlashStringHelper* symbole(uint8_t id) { \
+        return reinterpret_cast<const __FlashStringHelper*>(table()[borne(id)].texte); \
     } \
+    static float facteur(uint8_t id) { return pgm_read_float(&fiches()[borne(id)].facteur); } \
+    static DimensionsSI dimension(uint8_t id) { return RepertoireUnity::lireFiche(&fiches()[borne(id)]).dimension; } \
+    static uint8_t borne(uint8_t id) { return id < NB_ENTREES ? id : (uint8_t)AUCUNE; } \
+};
+
+
+// ============================================================================
+// TRAMES BINAIRES (TÉLÉMÉTRIE LoRa, RS-485...)
+// ============================================================================
+
+/**
+ * Codage binaire des mesures, identifiées par leur classe dans un répertoire
+ * (DECLARE_UNITY_REPERTOIRE). Octets en petit-boutiste :
+ *
+ *   entête   VERSION << 4 (4 bits bas réservés, à 0)
+ *   puis, pour chaque mesure :
+ *   unité    identifiant dans le répertoire (1..254)
+ *   format   bits 0-1 : codage de la valeur (FLOAT32, FLOAT16, ENTIER16, ENTIER32)
+ *            bits 2-6 : exposant décimal e des entiers (-16..15, complément à 2)
+ *            bit 7    : écart d'horodatage présent
+ *   écart    si bit 7 : entier non signé LEB128 (7 bits par octet), instant
+ *            moins l'instant précédent de la trame (0 en début de trame)
+ *   valeur   4 ou 2 octets ; entiers : valeur = n × 10^e
+ *
+ * 12.50 V en ENTIER16 au centième occupe 4 octets, contre 7 pour " 12.50V".
+ * FLOAT16 (IEEE binaire 16) garde 3 chiffres significatifs de 6e-8 à 65504.
+ */
+struct TrameUnity {
+    static constexpr uint8_t VERSION = 1;
+    static constexpr uint8_t HORODATEE = 0x80;  // Bit 7 du format
+    static constexpr int EXPOSANT_MIN = -16;
+    static constexpr int EXPOSANT_MAX = 15;
+
+    enum Codage : uint8_t { FLOAT32 = 0, FLOAT16 = 1, ENTIER16 = 2, ENTIER32 = 3 };
+
+    static uint8_t codage(uint8_t format) { return format & 0x03; }
+
+    static int exposant(uint8_t format) {
+        int e = (format >> 2) & 0x1F;
+        return e > EXPOSANT_MAX ? e - 32 : e;
+    }
+
+    static uint8_t octetsValeur(uint8_t format) {
+        return codage(format) == FLOAT16 || codage(format) == ENTIER16 ? 2 : 4;
+    }
+
+    /**
+     * float vers IEEE binaire 16, arrondi au plus proche (pair en cas
+     * d'égalité), en arithmétique entière : pas de demi-flottant sur AVR
+     */
+    static uint16_t versDemi(float v) {
+        uint32_t x;
+        memcpy(&x, &v, sizeof(x));
+        uint16_t signe = (uint16_t)((x >> 16) & 0x8000);
+        uint32_t module = x & 0x7FFFFFFFUL;
+
+        if (module >= 0x7F800000UL) return signe | (module > 0x7F800000UL ? 0x7E00 : 0x7C00); // nan, inf
+        if (module >= 0x477FF000UL) return signe | 0x7C00;  // >= 65520 : arrondi à l'infini
+        if (module < 0x38800000UL) {                         // < 2^-14 : sous-normal
+            if (module <= 0x33000000UL) return signe;        // <= 2^-25 : arrondi à 0
+            uint32_t mantisse = (module & 0x7FFFFFUL) | 0x800000UL;
+            int decalage = 126 - (int)(module >> 23);        // 14..24
+            uint32_t demi = mantisse >> decalage;
+            uint32_t reste = mantisse & ((1UL << decalage) - 1);
+            uint32_t moitie = 1UL << (decalage - 1);
+            if (reste > moitie || (reste == moitie && (demi & 1))) demi++;
+            return signe | (uint16_t)demi;
+        }
+        uint32_t demi = (module - 0x38000000UL) >> 13;       // Exposant rebiaisé (127 -> 15)
+        uint32_t reste = module & 0x1FFF;
+        if (reste > 0x1000 || (reste == 0x1000 && (demi & 1))) demi++; // Retenue possible vers l'exposant
+        return signe | (uint16_t)demi;
+    }
+
+    static float depuisDemi(uint16_t h) {
+        uint32_t signe = (uint32_t)(h & 0x8000) << 16;
+        uint32_t e = (h >> 10) & 0x1F;
+        uint32_t mantisse = h & 0x3FF;
+        uint32_t x;
+        if (e == 0x1F) {
+            x = signe | 0x7F800000UL | (mantisse << 13);
+        } else if (e) {
+            x = signe | ((e + 112) << 23) | (mantisse << 13);
+        } else if (mantisse == 0) {
+            x = signe;
+        } else {                                             // Sous-normal : normalisé
+            e = 113;
+            while (!(mantisse & 0x400)) { mantisse <<= 1; e--; }
+            x = signe | (e << 23) | ((mantisse & 0x3FF) << 13);
+        }
+        float v;
+        memcpy(&v, &x, sizeof(v));
+        return v;
+    }
+
+    // val × 10^e (|e| <= 16), quotient pour e < 0 : 0.01 n'est pas exact
+    static double decaler(double val, int e) {
+        double puissance = 1.0;
+        for (int k = e < 0 ? -e : e; k > 0; k--) puissance *= 10.0;
+        return e < 0 ? val / puissance : val * puissance;
+    }
+
+    static void ecrire16(uint8_t* p, uint16_t v) {
+        p[0] = (uint8_t)v;
+        p[1] = (uint8_t)(v >> 8);
+    }
+
+    static void ecrire32(uint8_t* p, uint32_t v) {
+        ecrire16(p, (uint16_t)v);
+        ecrire16(p + 2, (uint16_t)(v >> 16));
+    }
+
+    static uint16_t lire16(const uint8_t* p) { return (uint16_t)(p[0] | ((uint16_t)p[1] << 8)); }
+    static uint32_t lire32(const uint8_t* p) { return lire16(p) | ((uint32_t)lire16(p + 2) << 16); }
+};
+
+/**
+ * Mesure lue dans une trame : une vue sur ses octets, sans copie. La valeur
+ * n'est décodée qu'à la demande, dans la représentation voulue
+ */
+struct MesureTrame {
+    uint8_t unite;         // Identifiant dans le répertoire
+    uint8_t format;        // Voir TrameUnity
+    uint32_t instant;      // Horodatage cumulé (0 si aucune mesure horodatée avant)
+    const uint8_t* brut;   // Valeur, dans la trame
+
+    bool horodatee() const { return (format & TrameUnity::HORODATEE) != 0; }
+
+    template <class V = float>
+    V valeur() const {
+        switch (TrameUnity::codage(format)) {
+        case TrameUnity::FLOAT32: {
+            uint32_t x = TrameUnity::lire32(brut);
+            float f;
+            memcpy(&f, &x, sizeof(f));
+            return V(f);
+        }
+        case TrameUnity::FLOAT16:
+            return V(TrameUnity::depuisDemi(TrameUnity::lire16(brut)));
+        case TrameUnity::ENTIER16:
+            return V(TrameUnity::decaler((int16_t)TrameUnity::lire16(brut), TrameUnity::exposant(format)));
+        default:
+            return V(TrameUnity::decaler((int32_t)TrameUnity::lire32(brut), TrameUnity::exposant(format)));
+        }
+    }
+};
+
+/**
+ * Écriture d'une trame dans le tampon de l'appelant, pour le répertoire R :
+ *   uint8_t trame[32];
+ *   EcritureTrame<RepertoireSI> e(trame, sizeof(trame));
+ *   e.horodater(millis());
+ *   e.ajouter(tension, TrameUnity::ENTIER16, -2);  // Au centième de volt
+ *   e.ajouter(temperature, TrameUnity::FLOAT16);
+ *   radio.envoyer(trame, e.taille());
+ * Une mesure qui ne tient pas dans le tampon n'est pas écrite (ajouter()
+ * retourne false) : la trame reste valide.
+ */
+template <class R>
+class EcritureTrame {
+public:
+    EcritureTrame(uint8_t* o, size_t c) : out(o), cap(c), len(0), precedent(0), instant(0), horodatage(false) {
+        if (cap) out[len++] = TrameUnity::VERSION << 4;
+    }
+
+    // La prochaine mesure écrite porte cet instant (ms, ticks... au choix de l'application)
+    void horodater(uint32_t t) {
+        instant = t;
+        horodatage = true;
+    }
+
+    /**
+     * Ajoute une grandeur d'une classe du répertoire. ENTIER16 passe à
+     * ENTIER32 si n = val / 10^exposant dépasse 16 bits ; false si n dépasse
+     * 32 bits, si la valeur n'est pas un nombre (entiers) ou si la place manque
+     */
+    template <class G>
+    bool ajouter(const G& g, uint8_t codage = TrameUnity::FLOAT32, int exposant = 0) {
+        return ajouter(R::template identifiant<G>(), ScalaireUnity<typename G::Scalaire>::versDouble(g.getValeur()), codage, exposant);
+    }
+
+    bool ajouter(uint8_t unite, double val, uint8_t codage = TrameUnity::FLOAT32, int exposant = 0) {
+        uint8_t octets[4];
+        int32_t n = 0;
+        codage &= 0x03;
+
+        if (codage == TrameUnity::ENTIER16 || codage == TrameUnity::ENTIER32) {
+            if (exposant < TrameUnity::EXPOSANT_MIN || exposant > TrameUnity::EXPOSANT_MAX) return false;
+            double x = TrameUnity::decaler(val, -exposant);
+            if (!(x > -2147483648.5 && x < 2147483647.5)) return false; // Hors 32 bits, ou nan
+            n = (int32_t)(x < 0 ? x - 0.5 : x + 0.5);
+            codage = n >= -32768 && n <= 32767 ? TrameUnity::ENTIER16 : TrameUnity::ENTIER32;
+        } else {
+            exposant = 0;
+        }
+
+        uint8_t format = (uint8_t)(codage | (((unsigned)exposant & 0x1F) << 2));
+        if (horodatage) format |= TrameUnity::HORODATEE;
+
+        switch (codage) {
+        case TrameUnity::FLOAT32: {
+            float f = (float)val;
+            uint32_t x;
+            memcpy(&x, &f, sizeof(x));
+            TrameUnity::ecrire32(octets, x);
+            break;
+        }
+        case TrameUnity::FLOAT16: TrameUnity::ecrire16(octets, TrameUnity::versDemi((float)val)); break;
+        case TrameUnity::ENTIER16: TrameUnity::ecrire16(octets, (uint16_t)n); break;
+        default: TrameUnity::ecrire32(octets, (uint32_t)n); break;
+        }
+
+        // Place nécessaire : unité, format, écart (5 octets au plus), valeur
+        uint32_t ecart = instant - precedent;
+        uint8_t octetsEcart = 0;
+        if (horodatage) {
+            uint32_t e = ecart;
+            do { octetsEcart++; e >>= 7; } while (e);
+        }
+        uint8_t taille = TrameUnity::octetsValeur(format);
+        if (len + 2 + octetsEcart + taille > cap) return false;
+
+        out[len++] = unite;
+        out[len++] = format;
+        if (horodatage) {
+            while (ecart >= 0x80) {
+                out[len++] = (uint8_t)(ecart | 0x80);
+                ecart >>= 7;
+            }
+            out[len++] = (uint8_t)ecart;
+            precedent = instant;
+            horodatage = false;
+        }
+        memcpy(out + len, octets, taille);
+        len += taille;
+        return true;
+    }
+
+    size_t taille() const { return len; }
+
+private:
+    uint8_t* out;
+    size_t cap;
+    size_t len;
+    uint32_t precedent;  // Instant de la dernière mesure horodatée
+    uint32_t instant;
+    bool horodatage;     // horodater() appelé depuis la dernière mesure
+};
+
+/**
+ * Lecture d'une trame sur place (aucune copie, aucune allocation) :
+ *   LectureTrame<RepertoireSI> l(trame, taille);
+ *   MesureTrame m;
+ *   while (l.suivante(m)) {
+ *       Tension v;
+ *       if (l.vers(m, v)) ...                       // Objet typé si l'unité correspond
+ *       l.afficher(m, Serial, 2); Serial.println(); // Ou texte : " 12.50V"
+ *   }
+ *   if (l.erreur()) ...                             // Trame tronquée ou d'une autre version
+ */
+template <class R>
+class LectureTrame {
+public:
+    LectureTrame(const uint8_t* d, size_t taille) : p(d), fin(d + taille), instant(0), invalide(false) {
+        if (p == fin || (*p >> 4) != TrameUnity::VERSION) invalide = true;
+        else p++;
+    }
+
+    // Mesure suivante ; false en fin de trame ou sur erreur
+    bool suivante(MesureTrame& m) {
+        if (invalide || p == fin) return false;
+        if (fin - p < 2) return echec();
+        m.unite = p[0];
+        m.format = p[1];
+        const uint8_t* q = p + 2;
+
+        if (m.format & TrameUnity::HORODATEE) {
+            uint32_t ecart = 0;
+            for (uint8_t decalage = 0;; decalage += 7) {
+                if (q == fin || decalage > 28) return echec();
+                uint8_t octet = *q++;
+                ecart |= (uint32_t)(octet & 0x7F) << decalage;
+                if (!(octet & 0x80)) break;
+            }
+            instant += ecart;
+        }
+        m.instant = instant;
+
+        uint8_t taille = TrameUnity::octetsValeur(m.format);
+        if (m.unite == R::AUCUNE || m.unite >= R::NB_ENTREES || fin - q < taille) return echec();
+        m.brut = q;
+        p = q + taille;
+        return true;
+    }
+
+    bool erreur() const { return invalide; }
+
+    // Mesure vers un objet typé : false si elle n'est pas de la classe de g
+    template <class G>
+    static bool vers(const MesureTrame& m, G& g) {
+        if (m.unite != R::template identifiant<G>()) return false;
+        g = G(m.valeur<typename G::Scalaire>());
+        return true;
+    }
+
+    // Mesure en texte, avec le symbole de sa classe (comme valeurAvecUnite)
+    static size_t afficher(const MesureTrame& m, char* out, size_t cap, int nbDecimal = 3) {
+        return C_UNITY_BASE::valeurAvecUnite(out, cap, m.valeur<float>(), R::symbole(m.unite), nbDecimal);
+    }
+
+    static size_t afficher(const MesureTrame& m, Print& sortie, int nbDecimal = 3) {
+        return C_UNITY_BASE::valeurAvecUnite(sortie, m.valeur<float>(), R::symbole(m.unite), nbDecimal);
+    }
+
+private:
+    const uint8_t* p;
+    const uint8_t* fin;
+    uint32_t instant;
+    bool invalide;
+
+    bool echec() {
+        invalide = true;
+        return false;
+    }
+};
+
+// ============================================================================
+// STATISTIQUES EN CONTINU (MIN, MAX, MOYENNE, ÉCART-TYPE, RMS)
+// ============================================================================
+
+/**
+ * Statistiques d'une voie de mesure, tenues à jour à chaque échantillon en
+ * mémoire constante (la RMS ne relit aucun tampon) :
+ *
+ *   Stats<Tension> s;
+ *   s.ajouter(v);                       // À chaque échantillon
+ *   s.moyenne().afficher(Serial);       // Résultats typés : Tension
+ *   s.rms().afficher(Serial);
+ *
+ * Moyenne et somme des carrés des écarts par la méthode de Welford, chacune
+ * sommée avec compensation de Kahan : sur AVR (double = float), la moyenne
+ * de dix millions d'échantillons reste juste à la précision du float, là où
+ * une somme simple cesse de croître. C : type des calculs.
+ * Les accumulateurs partiels (interruption et boucle, plusieurs cartes...)
+ * se combinent par fusionner(). Un échantillon invalide (nan, ou
+ * VirguleFixe::invalide() : capteur en défaut) est ignoré.
+ */
+template <class G, class C = double>
+class Stats {
+public:
+    typedef typename G::Scalaire T;
+
+    Stats() { effacer(); }
+
+    void effacer() {
+        n = 0;
+        moy = resteMoy = m2 = resteM2 = 0;
+        mini = maxi = T();
+    }
+
+    void ajouter(const G& g) { ajouter(g.getValeur()); }
+
+    void ajouter(T val) {
+        if (!ScalaireUnity<T>::estValide(val)) return;
+        C x = (C)ScalaireUnity<T>::versDouble(val);
+        if (n == 0) {
+            mini = maxi = val;
+        } else {
+            if (val < mini) mini = val;
+            if (maxi < val) maxi = val;
+        }
+        n++;
+        C ecart = x - moy;
+        sommer(moy, resteMoy, ecart / (C)n);
+        sommer(m2, resteM2, ecart * (x - moy));
+    }
+
+    void ajouter(const T* vals, size_t nb) {
+        for (size_t i = 0; i < nb; i++) ajouter(vals[i]);
+    }
+
+    /**
+     * Ajoute les échantillons d'un autre accumulateur (Chan et al.) : même
+     * résultat, aux arrondis près, que s'ils étaient tous passés par celui-ci
+     */
+    void fusionner(const Stats& autre) {
+        if (autre.n == 0) return;
+        if (n == 0) {
+            *this = autre;
+            return;
+        }
+        C na = (C)n, nb = (C)autre.n, total = na + nb;
+        C ecart = (autre.moy - moy) + (autre.resteMoy - resteMoy);
+        sommer(moy, resteMoy, ecart * (nb / total));
+        sommer(m2, resteM2, autre.m2);
+        sommer(m2, resteM2, autre.resteM2 + ecart * ecart * (na * nb / total));
+        if (autre.mini < mini) mini = autre.mini;
+        if (maxi < autre.maxi) maxi = autre.maxi;
+        n += autre.n;
+    }
+
+    Stats& operator+=(const Stats& autre) {
+        fusionner(autre);
+        return *this;
+    }
+
+    // Résultats (invalides, nan pour float/double, tant que rien n'est ajouté)
+    uint32_t nombre() const { return n; }
+    G minimum() const { return n ? G(mini) : invalide(); }
+    G maximum() const { return n ? G(maxi) : invalide(); }
+    G moyenne() const { return n ? G(T(moy + resteMoy)) : invalide(); }
+
+    // Variance de la population (en unité au carré : pas de classe typée)
+    T variance() const { return n ? T(ecarts() / (C)n) : ScalaireUnity<T>::invalide(); }
+
+    G ecartType() const { return n ? G(T((C)sqrt((double)(ecarts() / (C)n)))) : invalide(); }
+
+    // Estimateur sans biais (n - 1) : dispersion d'une série de mesures
+    G ecartTypeEchantillon() const {
+        return n > 1 ? G(T((C)sqrt((double)(ecarts() / (C)(n - 1))))) : invalide();
+    }
+
+    // Valeur efficace : RMS² = moyenne² + variance
+    G rms() const {
+        if (!n) return invalide();
+        C m = moy + resteMoy;
+        return G(T((C)sqrt((double)(m * m + ecarts() / (C)n))));
+    }
+
+private:
+    uint32_t n;
+    C moy, resteMoy;  // Moyenne courante et partie perdue par l'arrondi
+    C m2, resteM2;    // Somme des carrés des écarts à la moyenne
+    T mini, maxi;
+
+    static G invalide() { return G(ScalaireUnity<T>::invalide()); }
+
+    C ecarts() const {
+        C e = m2 + resteM2;
+        return e > 0 ? e : 0;
+    }
+
+    // Somme compensée (Kahan) : somme + reste vaut la somme exacte à l'arrondi près
+    static void sommer(C& somme, C& reste, C terme) {
+        C y = terme + reste;
+        C t = somme + y;
+        reste = y - (t - somme);
+        somme = t;
+    }
+};
+
+
+// ============================================================================
+// AFFICHAGE STABLE (TEXTE MÉMORISÉ, HYSTÉRÉSIS DE PRÉFIXE)
+// ============================================================================
+
+/**
+ * Formateur attaché à une grandeur affichée en continu (écran, tableau de
+ * bord) :
+ *
+ *   AffichageStable<Tension> ecran(2);        // 2 décimales, hystérésis 5 %
+ *   ecran.texte(v);                           // À chaque rafraîchissement
+ *   if (ecran.aChange()) lcd.print(ecran.texte());
+ *
+ * Le dernier texte est gardé avec l'intervalle de valeurs qui l'affichent à
+ * l'identique : tant que la mesure y reste, texte() le rend après deux
+ * comparaisons, sans formater. Une mesure qui oscille autour d'un changement
+ * de préfixe (999.8 mV / 1.000 V) ne fait plus clignoter l'affichage : on ne
+ * redescend au préfixe inférieur qu'une fois la valeur tombée sous
+ * 1 / (1 + hysteresis) du préfixe courant (0.952 V pour 5 %), la montée se
+ * faisant toujours à 1000. Avec une hystérésis nulle, le texte est celui de
+ * afficher().
+ */
+template <class G, size_t N = 32>
+class AffichageStable {
+public:
+    typedef typename G::Scalaire T;
+
+    explicit AffichageStable(int nbDecimal = 3, float hysteresis = 0.05f, bool espaceAvantUnite = true)
+        : nbDecimal(nbDecimal), espace(espaceAvantUnite), maintien(1.0 / (1.0 + (double)hysteresis)) {
+        effacer();
+    }
+
+    // Oublie le texte mémorisé : le prochain appel formate
+    void effacer() {
+        bas = 1.0;
+        haut = 0.0;  // Intervalle vide
+        indice = -1;
+        invalide = false;
+        change = false;
+        longueur = 0;
+        tampon[0] = '\0';
+    }
+
+    const char* texte(const G& g) { return texte(g.getValeur()); }
+
+    const char* texte(T val) {
+        double v = ScalaireUnity<T>::versDouble(val);
+        change = false;
+        if (v >= bas && v <= haut) return tampon;
+        bool nan = C_UNITY_BASE::estInvalide(val);
+        if (nan && invalide) return tampon;
+        formater(val, v, nan);
+        return tampon;
+    }
+
+    // Dernier texte rendu, et s'il diffère du précédent (rien à redessiner sinon)
+    const char* texte() const { return tampon; }
+    size_t taille() const { return longueur; }
+    bool aChange() const { return change; }
+
+    size_t afficher(Print& sortie, const G& g) {
+        texte(g);
+        return sortie.write(reinterpret_cast<const uint8_t*>(tampon), longueur);
+    }
+
+private:
+    int nbDecimal;
+    bool espace;
+    double maintien;   // Seuil de descente, en fraction du préfixe courant
+    double bas, haut;  // Valeurs (bornes comprises) qui donnent le texte mémorisé
+    int indice;        // Préfixe du texte mémorisé (-1 : aucun)
+    bool invalide, change;
+    size_t longueur;
+    char tampon[N];
+
+    void formater(T val, double v, bool nan) {
+        int choisi = nan ? -1 : C_UNITY_BASE::indiceValeur(val);
+        double a = fabs(v), facteur = 0.0, pas = 1.0, ramenee = 0.0;
+        if (choisi >= 0 && a > 0.0) {
+            // Hystérésis : on garde le préfixe courant juste au-dessus du naturel
+            if (indice == choisi + 1 && a * facteurPrefixe(indice) >= maintien) choisi = indice;
+            for (int i = 0; i < nbDecimal; i++) pas *= 10.0;
+            facteur = facteurPrefixe(choisi) * pas;
+            ramenee = a * facteur;
+            if (ramenee + 0.5 >= 1000.0 * pas && choisi < C_UNITY_BASE::INDICE_MAX) {  // 999.9996 m -> 1.000
+                facteur = facteurPrefixe(++choisi) * pas;
+                ramenee = a * facteur;
+            }
+        }
+
+        char nouveau[N];
+        C_UNITY_BASE::Tampon t(nouveau, N);
+        C_UNITY_BASE::ecrireValeurClassee(t, val, choisi, nbDecimal, espace);
+        t.ajouter(G::symbole());
+        size_t n = t.terminer();
+
+        change = n != longueur || memcmp(nouveau, tampon, n) != 0;
+        memcpy(tampon, nouveau, n + 1);
+        longueur = n;
+        invalide = nan;
+        indice = choisi;
+        bas = 1.0;
+        haut = 0.0;
+        if (nan || choisi < 0) return;  // ε : reformaté à chaque appel
+        if (a == 0.0) {
+            bas = haut = 0.0;
+            return;
+        }
+        if (ramenee >= 4.0e9) return;   // Trop de décimales pour un entier 32 bits
+
+        // Valeurs qui arrondissent aux mêmes chiffres (k ± une demi-décimale),
+        // sans passer sous le seuil de descente, resserrées de quelques ulp
+        // du float pour couvrir les arrondis du moteur de formatage
+        double k = (double)(uint32_t)(ramenee + 0.5), inverse = 1.0 / facteur;
+        double b = (k - 0.5) * inverse, h = (k + 0.5) * inverse;
+        double seuil = maintien * pas * inverse;
+        if (b < seuil) b = seuil;
+        double marge = h * 5e-7;
+        b += marge;
+        h -= marge;
+        if (a < b || a > h) return;  // Valeur à la limite : pas de texte mémorisé
+        bas = v < 0 ? -h : b;
+        haut = v < 0 ? -b : h;
+    }
+
+    // Facteur du préfixe (ramène dans [1, 1000[), lu dans la table en flash
+    static double facteurPrefixe(int i) {
+        return (double)pgm_read_float(&C_UNITY_BASE::tablePrefixes()[i].facteur);
+    }
+};
+
+
+// ============================================================================
+// FILE DE MESURES (INTERRUPTION -> LOOP, SANS VERROU)
+// ============================================================================
+
+// Indice d'une file de N places : un octet jusqu'à 256 (lu d'un coup sur AVR)
+template <size_t N, bool = (N <= 256), bool = (N <= 65536UL)> struct IndiceFile { typedef uint32_t Type; };
+template <size_t N> struct IndiceFile<N, false, true> { typedef uint16_t Type; };
+template <size_t N> struct IndiceFile<N, true, true> { typedef uint8_t Type; };
+
+/**
+ * Accès aux indices et compteurs partagés de la file : builtins __atomic
+ * (acquire / release) sur PC, ESP32, RP2040. Sur AVR, un seul cœur, mais
+ * ni libgcc ni avr-libc ne fournissent les __atomic_load_2/4 qu'avr-gcc
+ * appelle au-delà d'un octet : accès volatile et barrière du compilateur,
+ * qui suffisent entre une interruption et loop().
+ */
+struct AccesFile {
+#if defined(__AVR__)
+    template <class X> static X acquerir(const X& x) {
+        X v = *(const volatile X*)&x;
+        __asm__ __volatile__("" ::: "memory");
+        return v;
+    }
+    template <class X> static void publier(X& x, X v) {
+        __asm__ __volatile__("" ::: "memory");
+        *(volatile X*)&x = v;
+    }
+    template <class X> static X lire(const X& x) { return *(const volatile X*)&x; }
+    template <class X> static void ecrire(X& x, X v) { *(volatile X*)&x = v; }
+#else
+    template <class X> static X acquerir(const X& x) { return __atomic_load_n(&x, __ATOMIC_ACQUIRE); }
+    template <class X> static void publier(X& x, X v) { __atomic_store_n(&x, v, __ATOMIC_RELEASE); }
+    template <class X> static X lire(const X& x) { return __atomic_load_n(&x, __ATOMIC_RELAXED); }
+    template <class X> static void ecrire(X& x, X v) { __atomic_store_n(&x, v, __ATOMIC_RELAXED); }
+#endif
+};
+
+/**
+ * File circulaire à un producteur et un consommateur, sans attente ni
+ * section critique : l'interruption du timer ajoute, loop() retire.
+ *
+ *   FileMesures<Courant, 64> file;
+ *   ISR(TIMER1_COMPA_vect) { file.ajouter(lireCourant()); }
+ *   void loop() {
+ *       float lot[16];
+ *       size_t n = file.retirer(lot, 16);           // Un lot par passage
+ *       Courant::afficher(Serial, lot, n);
+ *   }
+ *
+ * N, puissance de deux, est la taille du tableau ; la file tient N - 1
+ * mesures (une place reste vide pour distinguer pleine de vide, comme le
+ * tampon de HardwareSerial). Chaque côté n'écrit que son propre indice,
+ * publié après les données par une écriture « release » : sur AVR ce sont
+ * des octets, lus et écrits d'un coup, d'où N <= 256. Aussi valable entre
+ * deux threads (ou deux cœurs) sur PC, ESP32, RP2040.
+ * Une mesure ajoutée à une file pleine est perdue et comptée (pertes()) ;
+ * niveauMax() garde le remplissage le plus haut atteint, pour dimensionner N.
+ */
+template <class G, size_t N = 64>
+class FileMesures {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "La taille d'une FileMesures doit etre une puissance de deux");
+#if defined(__AVR__)
+    static_assert(N <= 256, "Sur AVR, une FileMesures a au plus 256 places (indices lus d'un coup)");
+#endif
+
+public:
+    typedef typename G::Scalaire T;
+    typedef typename IndiceFile<N>::Type Indice;
+
+    FileMesures() : tete(0), queue(0), maxi(0), perdues(0) {}
+
+    static constexpr size_t capacite() { return N - 1; }
+
+    // ------------------------------------------------------------------------
+    // Côté producteur (interruption, thread d'acquisition)
+    // ------------------------------------------------------------------------
+
+    // Faux si la file est pleine : la mesure est perdue et comptée
+    bool ajouter(T val) {
+        Indice t = tete;  // Seul le producteur écrit tete
+        Indice suivant = (Indice)((t + 1) & (N - 1));
+        Indice q = AccesFile::acquerir(queue);
+        if (suivant == q) {
+            compterPerte(1);
+            return false;
+        }
+        mesures[t] = val;
+        AccesFile::publier(tete, suivant);
+        noterNiveau((Indice)((suivant - q) & (N - 1)));
+        return true;
+    }
+
+    bool ajouter(const G& g) { return ajouter(g.getValeur()); }
+
+    // Bloc d'échantillons (DMA, lecture en rafale) : une seule publication.
+    // Retourne le nombre de mesures ajoutées, le reste est compté perdu
+    size_t ajouter(const T* vals, size_t n) {
+        Indice t = tete;
+        Indice q = AccesFile::acquerir(queue);
+        size_t libres = (size_t)((q - t - 1) & (N - 1));
+        size_t a = n < libres ? n : libres;
+        for (size_t i = 0; i < a; i++) mesures[(t + i) & (N - 1)] = vals[i];
+        AccesFile::publier(tete, (Indice)((t + a) & (N - 1)));
+        if (a < n) compterPerte(n - a);
+        noterNiveau((Indice)((t + a - q) & (N - 1)));
+        return a;
+    }
+
+    // ------------------------------------------------------------------------
+    // Côté consommateur (loop, thread d'affichage)
+    // ------------------------------------------------------------------------
+
+    bool retirer(T& val) {
+        Indice q = queue;  // Seul le consommateur écrit queue
+        if (q == AccesFile::acquerir(tete)) return false;
+        val = mesures[q];
+        AccesFile::publier(queue, (Indice)((q + 1) & (N - 1)));
+        return true;
+    }
+
+    bool retirer(G& g) {
+        T val;
+        if (!retirer(val)) return false;
+        g = G(val);
+        return true;
+    }
+
+    /**
+     * Retire jusqu'à nbMax mesures d'un coup (au plus deux copies contiguës,
+     * une seule publication) : le lot se formate ensuite en un appel,
+     * G::afficher(sortie, vals, n). Retourne le nombre de mesures retirées
+     */
+    size_t retirer(T* vals, size_t nbMax) {
+        Indice q = queue;
+        size_t n = (size_t)((AccesFile::acquerir(tete) - q) & (N - 1));
+        if (n > nbMax) n = nbMax;
+        size_t premier = N - q < n ? N - q : n;  // Jusqu'à la fin du tableau
+        for (size_t i = 0; i < premier; i++) vals[i] = mesures[q + i];
+        for (size_t i = premier; i < n; i++) vals[i] = mesures[i - premier];
+        AccesFile::publier(queue, (Indice)((q + n) & (N - 1)));
+        return n;
+    }
+
+    // Mesures en attente (exact côté consommateur, indicatif ailleurs)
+    size_t taille() const {
+        return (size_t)((AccesFile::acquerir(tete) - AccesFile::acquerir(queue)) & (N - 1));
+    }
+
+    bool vide() const { return taille() == 0; }
+
+    /**
+     * Compteurs du producteur, lus sans couper les interruptions : relus
+     * jusqu'à deux lectures identiques (un compteur de 32 bits se lit en
+     * quatre octets sur AVR)
+     */
+    uint32_t pertes() const {
+        uint32_t a, b;
+        do {
+            a = AccesFile::lire(perdues);
+            b = AccesFile::lire(perdues);
+        } while (a != b);
+        return a;
+    }
+
+    size_t niveauMax() const { return (size_t)AccesFile::lire(maxi); }
+
+private:
+    T mesures[N];
+    Indice tete;    // Prochaine place libre (écrit par le producteur)
+    Indice queue;   // Prochaine mesure à lire (écrit par le consommateur)
+    Indice maxi;
+    uint32_t perdues;
+
+    void compterPerte(size_t n) {
+        AccesFile::ecrire(perdues, perdues + (uint32_t)n);
+    }
+
+    void noterNiveau(Indice niveau) {
+        if (niveau > maxi) AccesFile::ecrire(maxi, niveau);
+    }
+};
+
+
+// ============================================================================
+// TABLEAUX DE GRANDEURS (STOCKAGE CONTIGU, OPÉRATIONS EN BLOC)
+// ============================================================================
+
+/**
+ * Jusqu'à N valeurs d'une même classe, rangées à la suite dans un tableau
+ * de G::Scalaire : l'unité n'existe qu'à la compilation, comme pour un
+ * objet seul. Chaque opération est une boucle sur le tableau, écrite avec
+ * les opérateurs de la classe (mêmes dimensions vérifiées, mêmes facteurs
+ * d'unité, mêmes arrondis qu'élément par élément) et vectorisée à
+ * l'optimisation.
+ *
+ *   TableauGrandeurs<Tension, 64> u;
+ *   TableauGrandeurs<Courant, 64> i;
+ *   for (...) { u.ajouter(lireTension()); i.ajouter(lireCourant()); }
+ *   u.affine(GAIN_U, Tension(-0.012));        // Étalonnage : u * k + d
+ *   TableauGrandeurs<Puissance, 64> p = u * i;
+ *   p.moyenne().afficher(Serial);
+ *   u.afficher(Serial);                       // "229.870V;230.012V;..."
+ *
+ * Les opérations entre deux tableaux portent sur le plus court des deux.
+ * Sommes, minimum et maximum par 8 accumulateurs entrelacés (vectorisables
+ * sans réassocier les flottants, et plus justes qu'une somme en série).
+ */
+template <class G, size_t N>
+class TableauGrandeurs {
+public:
+    typedef typename G::Scalaire T;
+
+    TableauGrandeurs() : n(0) {}
+
+    static constexpr size_t capacite() { return N; }
+    size_t taille() const { return n; }
+    void effacer() { n = 0; }
+
+    // Faux si le tableau est plein
+    bool ajouter(T val) {
+        if (n >= N) return false;
+        valeurs[n++] = val;
+        return true;
+    }
+
+    bool ajouter(const G& g) { return ajouter(g.getValeur()); }
+
+    // Copie d'un tableau de valeurs (ex. lot retiré d'une FileMesures) ; retourne le nombre copié
+    size_t ajouter(const T* vals, size_t nb) {
+        if (nb > N - n) nb = N - n;
+        for (size_t k = 0; k < nb; k++) valeurs[n + k] = vals[k];
+        n += nb;
+        return nb;
+    }
+
+    G operator[](size_t k) const { return G(valeurs[k]); }
+    void fixer(size_t k, const G& g) { valeurs[k] = g.getValeur(); }
+
+    // Accès direct aux valeurs, dans l'unité de G
+    T* donnees() { return valeurs; }
+    const T* donnees() const { return valeurs; }
+
+    // ------------------------------------------------------------------------
+    // Opérations élément par élément
+    // ------------------------------------------------------------------------
+
+    TableauGrandeurs& operator*=(T k) {
+        for (size_t j = 0; j < n; j++) valeurs[j] = (G(valeurs[j]) * k).getValeur();
+        return *this;
+    }
+
+    // Décalage par une grandeur de même dimension (dans son unité)
+    template <class G2>
+    TableauGrandeurs& decaler(const G2& d) {
+        for (size_t j = 0; j < n; j++) valeurs[j] = (G(valeurs[j]) + d).getValeur();
+        return *this;
+    }
+
+    // Étalonnage en un passage : v * k + d
+    template <class G2>
+    TableauGrandeurs& affine(T k, const G2& d) {
+        for (size_t j = 0; j < n; j++) valeurs[j] = (G(valeurs[j]) * k + d).getValeur();
+        return *this;
+    }
+
+    template <class G2, size_t N2>
+    TableauGrandeurs& operator+=(const TableauGrandeurs<G2, N2>& b) {
+        const size_t m = commune(b);
+        for (size_t j = 0; j < m; j++) valeurs[j] = (G(valeurs[j]) + G2(b.donnees()[j])).getValeur();
+        return *this;
+    }
+
+    template <class G2, size_t N2>
+    TableauGrandeurs& operator-=(const TableauGrandeurs<G2, N2>& b) {
+        const size_t m = commune(b);
+        for (size_t j = 0; j < m; j++) valeurs[j] = (G(valeurs[j]) - G2(b.donnees()[j])).getValeur();
+        return *this;
+    }
+
+    // Produit et quotient de deux tableaux : tableau de la classe du résultat
+    // (Tension * Courant -> Puissance)
+    template <class G2, size_t N2>
+    TableauGrandeurs<decltype(G() * G2()), N> operator*(const TableauGrandeurs<G2, N2>& b) const {
+        TableauGrandeurs<decltype(G() * G2()), N> r;
+        const size_t m = commune(b);
+        for (size_t j = 0; j < m; j++) r.donnees()[j] = (G(valeurs[j]) * G2(b.donnees()[j])).getValeur();
+        r.redimensionner(m);
+        return r;
+    }
+
+    template <class G2, size_t N2>
+    TableauGrandeurs<decltype(G() / G2()), N> operator/(const TableauGrandeurs<G2, N2>& b) const {
+        TableauGrandeurs<decltype(G() / G2()), N> r;
+        const size_t m = commune(b);
+        for (size_t j = 0; j < m; j++) r.donnees()[j] = (G(valeurs[j]) / G2(b.donnees()[j])).getValeur();
+        r.redimensionner(m);
+        return r;
+    }
+
+    // Par une même grandeur (Courant * Resistance -> Tension)
+    template <class G2>
+    TableauGrandeurs<decltype(G() * G2()), N> operator*(const G2& g) const {
+        TableauGrandeurs<decltype(G() * G2()), N> r;
+        for (size_t j = 0; j < n; j++) r.donnees()[j] = (G(valeurs[j]) * g).getValeur();
+        r.redimensionner(n);
+        return r;
+    }
+
+    // Taille après écriture directe dans donnees() (au plus N)
+    void redimensionner(size_t taille) { n = taille < N ? taille : N; }
+
+    // ------------------------------------------------------------------------
+    // Réductions (tableau vide : somme nulle, NaN pour les autres)
+    // ------------------------------------------------------------------------
+
+    G somme() const {
+        T s[VOIES] = {};
+        size_t j = 0;
+        for (; N >= VOIES && j + VOIES <= n; j += VOIES)
+            for (size_t k = 0; k < VOIES; k++) s[k] += valeurs[j + k];
+        for (size_t k = 1; k < VOIES; k++) s[0] += s[k];
+        for (; j < n; j++) s[0] += valeurs[j];
+        return G(s[0]);
+    }
+
+    G moyenne() const { return n ? G(somme().getValeur() / T((typename ScalaireUnity<T>::Constante)n)) : G(ScalaireUnity<T>::invalide()); }
+    G minimum() const { return extremum(false); }
+    G maximum() const { return extremum(true); }
+
+    // ------------------------------------------------------------------------
+    // Affichage de tout le tableau en un appel ("1.200V;3.400V;...")
+    // ------------------------------------------------------------------------
+
+    size_t afficher(Print& sortie, char separateur = ';', int nbDecimal = 3) const {
+        return G::afficher(sortie, valeurs, n, separateur, nbDecimal);
+    }
+
+    size_t afficher(char* out, size_t cap, char separateur = ';', int nbDecimal = 3) const {
+        return G::afficher(out, cap, valeurs, n, separateur, nbDecimal);
+    }
+
+private:
+    static const size_t VOIES = 8;
+
+    T valeurs[N];
+    size_t n;
+
+    template <class G2, size_t N2>
+    size_t commune(const TableauGrandeurs<G2, N2>& b) const { return n < b.taille() ? n : b.taille(); }
+
+    G extremum(bool plusGrand) const {
+        if (n == 0) return G(ScalaireUnity<T>::invalide());
+        T e[VOIES];
+        for (size_t k = 0; k < VOIES; k++) e[k] = valeurs[0];
+        size_t j = 0;
+        if (plusGrand) {
+            for (; N >= VOIES && j + VOIES <= n; j += VOIES)
+                for (size_t k = 0; k < VOIES; k++) e[k] = e[k] < valeurs[j + k] ? valeurs[j + k] : e[k];
+        } else {
+            for (; N >= VOIES && j + VOIES <= n; j += VOIES)
+                for (size_t k = 0; k < VOIES; k++) e[k] = valeurs[j + k] < e[k] ? valeurs[j + k] : e[k];
+        }
+        for (; j < n; j++) e[0] = (plusGrand ? e[0] < valeurs[j] : valeurs[j] < e[0]) ? valeurs[j] : e[0];
+        for (size_t k = 1; k < VOIES; k++) e[0] = (plusGrand ? e[0] < e[k] : e[k] < e[0]) ? e[k] : e[0];
+        return G(e[0]);
+    }
+};
+
+// ============================================================================
+// GRANDEURS COMPACTES (16 BITS, HISTORIQUES EN RAM)
+// ============================================================================
+
+/**
+ * Codage logarithmique sur les préfixes SI :
+ *
+ *   bit 15       signe
+ *   bits 14..11  préfixe, indice de la table des préfixes - 4 (atto ... ronna)
+ *   bits 10..0   m : mantisse = 1000^(m / 2048), dans [1, 1000[
+ *
+ * Valeur = mantisse × préfixe. Pas constant de 0.34 % : erreur relative
+ * d'au plus 0.17 % de 1.0034e-18 à 9.93e29 (toutes les classes, du pF au
+ * GW). Plus petit : 0 ; plus grand, infini ou NaN : NaN.
+ * Codage : log2 par l'exposant binaire et 4 termes de série, sans table
+ * ni libm ; décodage : facteur du préfixe et deux tables de 32 et 64 float
+ * en flash (384 octets), trois multiplications.
+ */
+struct CodageLogSI {
+    static constexpr int PREFIXE_MIN = 4;                       // atto
+    static constexpr int PREFIXE_MAX = PREFIXE_MIN + 15;        // ronna
+    static constexpr uint16_t INVALIDE = 0x7FFF;                // NaN
+    static constexpr float erreurRelative() { return 1.7e-3f; } // 1000^(1/4096) - 1 = 0.1688 %
+
+    static uint16_t coder(float v) {
+        uint32_t x;
+        memcpy(&x, &v, sizeof(x));
+        uint16_t signe = (uint16_t)((x >> 16) & 0x8000);
+        uint32_t module = x & 0x7FFFFFFFUL;
+        if (module >= 0x7F800000UL) return signe | INVALIDE;
+        if (module < pgm_read_dword(&C_UNITY_BASE::tablePrefixes()[PREFIXE_MIN].seuil)) return signe;
+
+        // log2|v| = e + log2(f), f dans [√2/2, √2[ : 2/ln2 × atanh((f - 1)/(f + 1)), 4 termes (4e-8 près)
+        int e = (int)(module >> 23) - 127;
+        uint32_t bitsF = (module & 0x7FFFFFUL) | 0x3F800000UL;
+        if (bitsF > 0x3FB504F3UL) {
+            bitsF -= 0x00800000UL;
+            e++;
+        }
+        float f;
+        memcpy(&f, &bitsF, sizeof(f));
+        float t = (f - 1.0f) / (f + 1.0f), t2 = t * t;
+        float l = t * (2.88539008f + t2 * (0.961796694f + t2 * (0.577078016f + t2 * 0.412198583f)));
+
+        // Rang du pas de 1000^(1/2048) compté depuis 10^-18, arrondi au plus proche, en
+        // virgule fixe 16.16 (e × pas exact) : le préfixe et la mantisse en sont les bits hauts et bas
+        int32_t n = (((int32_t)e * PAS_PAR_OCTAVE_16 + (int32_t)(l * (PAS_PAR_OCTAVE_16 * 1.0f)) + 0x8000) >> 16)
+                  + (C_UNITY_BASE::INDICE_UNITE - PREFIXE_MIN) * 2048;
+        if (n >= INVALIDE) return signe | INVALIDE;
+        return signe | (uint16_t)(n > 0 ? n : 1);
+    }
+
+    static float decoder(uint16_t code) {
+        uint16_t module = code & 0x7FFF;
+        float v;
+        if (module == 0) {
+            v = 0.0f;
+        } else if (module == INVALIDE) {
+            v = ScalaireUnity<float>::invalide();
+        } else {
+            int p = PREFIXE_MIN + (module >> 11);
+            uint16_t m = module & 0x7FF;
+            // facteur(2 × unité - p) = 10^(3 (p - unité))
+            v = pgm_read_float(&C_UNITY_BASE::tablePrefixes()[2 * C_UNITY_BASE::INDICE_UNITE - p].facteur)
+              * pgm_read_float(&tranches()[m >> 6]) * pgm_read_float(&pas()[m & 63]);
+        }
+        return code & 0x8000 ? -v : v;
+    }
+
+private:
+    static constexpr int32_t PAS_PAR_OCTAVE_16 = 13467854;   // 2048 / log2(1000) × 2^16
+
+    // 1000^(k/32)
+    static const float* tranches() {
+        static constexpr float table[32] PROGMEM = {
+            1.0f, 1.24093771f, 1.53992653f, 1.91095293f, 2.37137365f, 2.94272709f,
+            3.65174127f, 4.53158379f, 5.62341309f, 6.97830582f, 8.65964317f, 10.7460785f,
+            13.3352146f, 16.5481701f, 20.5352497f, 25.4829674f, 31.622776f, 39.2418976f,
+            48.6967506f, 60.4296379f, 74.989418f, 93.0572052f, 115.478195f, 143.301254f,
+            177.827942f, 220.673401f, 273.841949f, 339.820831f, 421.696503f, 523.299133f,
+            649.381653f, 805.842163f,
+        };
+        return table;
+    }
+
+    // 1000^(k/2048)
+    static const float* pas() {
+        static constexpr float table[64] PROGMEM = {
+            1.0f, 1.00337863f, 1.0067687f, 1.0101701f, 1.01358318f, 1.01700759f,
+            1.02044368f, 1.02389145f, 1.02735078f, 1.0308218f, 1.0343045f, 1.03779912f,
+            1.04130542f, 1.04482365f, 1.04835367f, 1.05189562f, 1.0554496f, 1.05901551f,
+            1.06259358f, 1.06618369f, 1.06978595f, 1.07340026f, 1.07702696f, 1.08066583f,
+            1.08431697f, 1.08798051f, 1.09165633f, 1.09534466f, 1.0990454f, 1.10275865f,
+            1.10648441f, 1.11022282f, 1.11397386f, 1.11773753f, 1.12151396f, 1.12530315f,
+            1.12910509f, 1.13291991f, 1.1367476f, 1.14058828f, 1.14444184f, 1.14830852f,
+            1.15218818f, 1.15608108f, 1.15998697f, 1.16390622f, 1.16783857f, 1.17178428f,
+            1.17574322f, 1.17971563f, 1.18370152f, 1.18770075f, 1.19171357f, 1.19573987f,
+            1.19977987f, 1.20383346f, 1.20790076f, 1.21198177f, 1.21607661f, 1.22018528f,
+            1.22430778f, 1.22844434f, 1.23259473f, 1.23675919f,
+        };
+        return table;
+    }
+};
+
+/**
+ * IEEE binaire 16 (celui des trames) : erreur relative d'au plus 2^-11
+ * (0.049 %) de 6.1e-5 à 65504, sous-normaux jusqu'à 6e-8 ; au-delà : infini.
+ * Plus précis que CodageLogSI sur cette plage (tensions, courants en A,
+ * températures), sans le pF ni le GHz.
+ */
+struct CodageDemi {
+    static constexpr float erreurRelative() { return 4.8828125e-4f; }  // 2^-11
+    static uint16_t coder(float v) { return TrameUnity::versDemi(v); }
+    static float decoder(uint16_t code) { return TrameUnity::depuisDemi(code); }
+};
+
+/**
+ * Valeur d'une classe G sur 16 bits, pour doubler un historique en RAM :
+ *
+ *   GrandeurCompacte<Tension> historique[400];         // 800 octets au lieu de 1600
+ *   historique[i] = Tension(12.34);                    // Codage (erreur <= 0.17 %)
+ *   Tension v = historique[i];                         // Décodage
+ *   historique[i].afficher(Serial);                    // " 12.333V"
+ *   GrandeurCompacte<Temperature, CodageDemi> t;       // Demi-flottant (0.049 %)
+ *
+ * GrandeurCompacte<G>::erreurRelative() donne la borne de l'erreur relative du codage.
+ */
+template <class G, class Codage = CodageLogSI>
+class GrandeurCompacte {
+public:
+    typedef typename G::Scalaire T;
+
+    GrandeurCompacte() : code(0) {}
+    GrandeurCompacte(const G& g) : code(Codage::coder((float)g.getValeur())) {}
+
+    static constexpr float erreurRelative() { return Codage::erreurRelative(); }
+
+    float getValeur() const { return Codage::decoder(code); }
+    G grandeur() const { return G(T(getValeur())); }
+    operator G() const { return grandeur(); }
+
+    // Code brut (trames, EEPROM)
+    uint16_t brut() const { return code; }
+    static GrandeurCompacte depuisBrut(uint16_t c) {
+        GrandeurCompacte g;
+        g.code = c;
+        return g;
+    }
+
+    size_t afficher(Print& sortie, int nbDecimal = 3) const { return G::afficher(sortie, T(getValeur()), nbDecimal); }
+    size_t afficher(char* out, size_t cap, int nbDecimal = 3) const { return G::afficher(out, cap, T(getValeur()), nbDecimal); }
+
+    // Tableaux entiers (historique sauvegardé, relu pour une courbe)
+    static void coder(const T* vals, GrandeurCompacte* codes, size_t n) {
+        for (size_t k = 0; k < n; k++) codes[k].code = Codage::coder((float)vals[k]);
+    }
+
+    static void decoder(const GrandeurCompacte* codes, T* vals, size_t n) {
+        for (size_t k = 0; k < n; k++) vals[k] = T(Codage::decoder(codes[k].code));
+    }
+
+private:
+    uint16_t code;
 };
 
+// ============================================================================
+// SÉRIES TEMPORELLES (HISTORIQUE CIRCULAIRE, PYRAMIDE MIN/MAX/MOYENNE)
+// ============================================================================
+
+/**
+ * Les N dernières mesures d'une classe, pour les tracer sans relire tout
+ * l'historique à chaque rafraîchissement :
+ *
+ *   SerieTemporelle<Tension, 4096> u;                  // Plus d'une heure à 1 Hz
+ *   u.ajouter(lireTension());                          // À chaque mesure
+ *   SerieTemporelle<Tension, 4096>::Point courbe[120];
+ *   size_t n = u.decimerMinMax(u.premier(), u.fin(), courbe, 120);
+ *   u.resumer(u.fin() - 600, u.fin()).moyenne.afficher(Serial);   // 10 dernières minutes
+ *
+ * Chaque mesure a un rang (nombre de mesures ajoutées avant elle) ; sont
+ * conservés les rangs premier() à fin() - 1, les plages demandées y sont
+ * ramenées. Une mesure invalide (nan, ou VirguleFixe::invalide() : capteur
+ * en défaut) est ignorée, comme dans Stats : elle ne prend pas de rang et
+ * n'entre ni dans les sommes ni dans les courbes.
+ * Aux valeurs s'ajoute une pyramide de résumés (minimum, maximum,
+ * somme) par blocs alignés de B, 2B, 4B... N mesures, tenue à jour à chaque
+ * ajout (coût amorti constant) : une plage se résume par au plus deux
+ * blocs par niveau et moins de 2B mesures aux bords, en O(B + log N)
+ * quelle que soit sa longueur. Les courbes de P points coûtent donc
+ * O(P (B + log N)) : le plus grand et le plus petit de chaque tranche se
+ * retrouvent en descendant la pyramide.
+ * N et B puissances de deux ; place des résumés : 2N/B blocs (minimum,
+ * maximum, somme en double), 3N/8 octets sur AVR pour B = 16, moins que
+ * les valeurs. Rangs sur 32 bits : 49 jours à 1 kHz.
+ */
+template <class G, size_t N, size_t B = 16>
+class SerieTemporelle {
+    static_assert(N >= B && (N & (N - 1)) == 0, "La taille d'une SerieTemporelle doit etre une puissance de deux");
+    static_assert(B >= 2 && (B & (B - 1)) == 0, "Les blocs d'une SerieTemporelle doivent etre une puissance de deux");
+
+public:
+    typedef typename G::Scalaire T;
+
+    // Point d'une courbe : rang de la mesure et valeur, dans l'unité de G
+    struct Point {
+        uint32_t rang;
+        T valeur;
+    };
+
+    // Résumé d'une plage (invalides, nan pour float/double, si elle est vide)
+    struct Resume {
+        uint32_t nombre;
+        G minimum, maximum, moyenne;
+    };
+
+    SerieTemporelle() : n(0) {}
+
+    static constexpr size_t capacite() { return N; }
+    void effacer() { n = 0; }
+
+    uint32_t fin() const { return n; }
+    uint32_t premier() const { return n > N ? n - (uint32_t)N : 0; }
+    size_t taille() const { return n > N ? N : n; }
+
+    // Mesure de rang r (premier() <= r < fin())
+    G operator[](uint32_t r) const { return G(valeurs[r & (N - 1)]); }
+
+    void ajouter(T val) {
+        if (!ScalaireUnity<T>::estValide(val)) return;
+        uint32_t r = n++;
+        valeurs[r & (N - 1)] = val;
+        double x = ScalaireUnity<T>::versDouble(val);
+        Bloc& b = bloc(0, r);
+        if (r % B == 0) {
+            b.mini = b.maxi = val;
+            b.somme = x;
+        } else {
+            if (val < b.mini) b.mini = val;
+            if (b.maxi < val) b.maxi = val;
+            b.somme += x;
+        }
+
+        // Bloc complet : les niveaux au-dessus dont il termine un bloc en sont tirés
+        for (size_t niveau = 1; niveau < NIVEAUX; niveau++) {
+            uint32_t largeur = (uint32_t)B << niveau;
+            if ((r + 1) % largeur) break;
+            uint32_t debut = r + 1 - largeur;
+            const Bloc& g = bloc(niveau - 1, debut);
+            const Bloc& d = bloc(niveau - 1, debut + largeur / 2);
+            Bloc& p = bloc(niveau, debut);
+            p.mini = d.mini < g.mini ? d.mini : g.mini;
+            p.maxi = g.maxi < d.maxi ? d.maxi : g.maxi;
+            p.somme = g.somme + d.somme;
+        }
+    }
+
+    void ajouter(const G& g) { ajouter(g.getValeur()); }
+
+    void ajouter(const T* vals, size_t nb) {
+        for (size_t k = 0; k < nb; k++) ajouter(vals[k]);
+    }
+
+    Resume resumer(uint32_t debut, uint32_t fin) const {
+        Cumul c;
+        borner(debut, fin);
+        cumuler(debut, fin, c);
+        Resume r;
+        r.nombre = c.nombre;
+        r.minimum = c.nombre ? G(c.mini) : invalide();
+        r.maximum = c.nombre ? G(c.maxi) : invalide();
+        r.moyenne = c.nombre ? G(T(c.somme / c.nombre)) : invalide();
+        return r;
+    }
+
+    /**
+     * Courbe min/max : la plage coupée en nbPoints / 2 tranches, le plus
+     * petit et le plus grand de chacune dans l'ordre des rangs (les crêtes
+     * brèves restent visibles). Une plage d'au plus nbPoints mesures est
+     * copiée telle quelle. Retourne le nombre de points écrits.
+     */
+    size_t decimerMinMax(uint32_t debut, uint32_t fin, Point* sortie, size_t nbPoints) const {
+        borner(debut, fin);
+        if (fin - debut <= nbPoints) return copier(debut, fin, sortie);
+        if (nbPoints < 2) return 0;
+
+        size_t tranches = nbPoints / 2;
+        uint32_t largeur = (uint32_t)((fin - debut + tranches - 1) / tranches);
+        size_t k = 0;
+        for (uint32_t a = debut; a < fin; a += largeur) {
+            uint32_t b = fin - a > largeur ? a + largeur : fin;
+            Cumul c;
+            cumuler(a, b, c);
+            uint32_t rMin = localiser(c.rangMin, c.niveauMin, c.mini, true);
+            uint32_t rMax = localiser(c.rangMax, c.niveauMax, c.maxi, false);
+            uint32_t r1 = rMin < rMax ? rMin : rMax, r2 = rMin < rMax ? rMax : rMin;
+            sortie[k++] = point(r1);
+            if (r2 != r1) sortie[k++] = point(r2);
+        }
+        return k;
+    }
+
+    /**
+     * Courbe LTTB (Largest-Triangle-Three-Buckets, Steinarsson) : première
+     * et dernière mesures, puis dans chaque tranche le point qui forme le
+     * plus grand triangle avec le point retenu avant lui et la moyenne de
+     * la tranche suivante (tirée de la pyramide). Les candidats d'une
+     * tranche sont les minimums et maximums de 4 sous-tranches (MinMaxLTTB),
+     * toutes ses mesures si elle en a au plus 8 : même courbe que LTTB sur
+     * les signaux tracés, sans parcourir la plage. nbPoints >= 3 ; une
+     * plage d'au plus nbPoints mesures est copiée telle quelle.
+     */
+    size_t decimerLTTB(uint32_t debut, uint32_t fin, Point* sortie, size_t nbPoints) const {
+        borner(debut, fin);
+        if (fin - debut <= nbPoints) return copier(debut, fin, sortie);
+        if (nbPoints < 3) return 0;
+
+        const size_t tranches = nbPoints - 2;
+        size_t k = 0;
+        sortie[k++] = point(debut);
+        uint32_t retenu = debut;
+        double yRetenu = ScalaireUnity<T>::versDouble(valeurs[debut & (N - 1)]);
+        for (size_t t = 0; t < tranches; t++) {
+            uint32_t a = borneLTTB(debut, fin, t, tranches), b = borneLTTB(debut, fin, t + 1, tranches);
+            uint32_t c = t + 2 <= tranches ? borneLTTB(debut, fin, t + 2, tranches) : fin;
+
+            Cumul suivante;
+            cumuler(b, c, suivante);
+            double xm = ((double)b + (double)(c - 1)) / 2 - retenu, ym = suivante.somme / suivante.nombre - yRetenu;
+
+            // Aire (au facteur 1/2 près) du triangle retenu, candidat, moyenne suivante
+            uint32_t meilleur = a;
+            double aireMax = -1;
+            uint32_t candidats[2 * SOUS_TRANCHES];
+            size_t nb = 0;
+            if (b - a <= 2 * SOUS_TRANCHES) {
+                for (uint32_t r = a; r < b; r++) candidats[nb++] = r;
+            } else {
+                for (uint32_t s = 0; s < SOUS_TRANCHES; s++) {
+                    Cumul sc;
+                    cumuler(a + (b - a) * s / SOUS_TRANCHES, a + (b - a) * (s + 1) / SOUS_TRANCHES, sc);
+                    candidats[nb++] = localiser(sc.rangMin, sc.niveauMin, sc.mini, true);
+                    candidats[nb++] = localiser(sc.rangMax, sc.niveauMax, sc.maxi, false);
+                }
+            }
+            for (size_t j = 0; j < nb; j++) {
+                double y = ScalaireUnity<T>::versDouble(valeurs[candidats[j] & (N - 1)]) - yRetenu;
+                double aire = fabs((double)(candidats[j] - retenu) * ym - xm * y);
+                if (aire > aireMax) {
+                    aireMax = aire;
+                    meilleur = candidats[j];
+                }
+            }
+            sortie[k++] = point(meilleur);
+            retenu = meilleur;
+            yRetenu = ScalaireUnity<T>::versDouble(valeurs[meilleur & (N - 1)]);
+        }
+        sortie[k++] = point(fin - 1);
+        return k;
+    }
+
+private:
+    static constexpr size_t NB_BLOCS_0 = N / B;
+
+    static constexpr size_t niveaux(size_t blocs) { return blocs <= 1 ? 1 : 1 + niveaux(blocs / 2); }
+    static constexpr size_t NIVEAUX = niveaux(NB_BLOCS_0);
+    static constexpr uint32_t SOUS_TRANCHES = 4;
+
+    struct Bloc {
+        T mini, maxi;
+        double somme;
+    };
+
+    // Plage en cours de résumé ; niveau du bloc où sont le minimum et le maximum (-1 : une mesure)
+    struct Cumul {
+        uint32_t nombre = 0;
+        T mini = T(), maxi = T();
+        double somme = 0;
+        uint32_t rangMin = 0, rangMax = 0;
+        int8_t niveauMin = -1, niveauMax = -1;
+    };
+
+    T valeurs[N];
+    Bloc blocs[2 * NB_BLOCS_0 - 1];  // Niveau 0 (blocs de B) puis chaque niveau au-dessus
+    uint32_t n;
+
+    static G invalide() { return G(ScalaireUnity<T>::invalide()); }
+
+    // Niveau k : NB_BLOCS_0 >> k blocs, rangés après ceux des niveaux inférieurs
+    Bloc& bloc(size_t niveau, uint32_t r) {
+        return blocs[2 * NB_BLOCS_0 - 2 * (NB_BLOCS_0 >> niveau) + ((r / ((uint32_t)B << niveau)) & ((NB_BLOCS_0 >> niveau) - 1))];
+    }
+    const Bloc& bloc(size_t niveau, uint32_t r) const { return const_cast<SerieTemporelle*>(this)->bloc(niveau, r); }
+
+    void borner(uint32_t& debut, uint32_t& fin) const {
+        if (fin > n) fin = n;
+        if (debut < premier()) debut = premier();
+        if (debut > fin) debut = fin;
+    }
+
+    Point point(uint32_t r) const {
+        Point p = { r, valeurs[r & (N - 1)] };
+        return p;
+    }
+
+    size_t copier(uint32_t debut, uint32_t fin, Point* sortie) const {
+        for (uint32_t r = debut; r < fin; r++) sortie[r - debut] = point(r);
+        return fin - debut;
+    }
+
+    static uint32_t borneLTTB(uint32_t debut, uint32_t fin, size_t t, size_t tranches) {
+        return debut + 1 + (uint32_t)((uint64_t)(fin - debut - 2) * t / tranches);
+    }
+
+    void inclure(Cumul& c, T mini, T maxi, double somme, uint32_t nombre, uint32_t r, int8_t niveau) const {
+        if (c.nombre == 0 || mini < c.mini) {
+            c.mini = mini;
+            c.rangMin = r;
+            c.niveauMin = niveau;
+        }
+        if (c.nombre == 0 || c.maxi < maxi) {
+            c.maxi = maxi;
+            c.rangMax = r;
+            c.niveauMax = niveau;
+        }
+        c.somme += somme;
+        c.nombre += nombre;
+    }
+
+    // Plage [a, b[ : mesures seules jusqu'à un bord de bloc, puis le plus grand bloc aligné qui tient
+    void cumuler(uint32_t a, uint32_t b, Cumul& c) const {
+        while (a < b) {
+            if (a % B || b - a < B) {
+                T v = valeurs[a & (N - 1)];
+                inclure(c, v, v, ScalaireUnity<T>::versDouble(v), 1, a, -1);
+                a++;
+                continue;
+            }
+            size_t niveau = 0;
+            while (niveau + 1 < NIVEAUX && a % ((uint32_t)B << (niveau + 1)) == 0 && b - a >= ((uint32_t)B << (niveau + 1))) niveau++;
+            const Bloc& g = bloc(niveau, a);
+            inclure(c, g.mini, g.maxi, g.somme, (uint32_t)B << niveau, a, (int8_t)niveau);
+            a += (uint32_t)B << niveau;
+        }
+    }
+
+    // Rang d'une mesure égale à v dans le bloc (niveau, r) : descente par la moitié qui la contient
+    uint32_t localiser(uint32_t r, int niveau, T v, bool minimum) const {
+        if (niveau < 0) return r;
+        for (; niveau > 0; niveau--) {
+            const Bloc& g = bloc(niveau - 1, r);
+            if (!((minimum ? g.mini : g.maxi) == v)) r += (uint32_t)B << (niveau - 1);
+        }
+        for (uint32_t k = 0; k < B; k++) {
+            if (valeurs[(r + k) & (N - 1)] == v) return r + k;
+        }
+        return r;
+    }
+};
 
 #endif // C_UNITY_H
@@ -0,0 +1,164 @@
+// banc.h - Outils communs des bancs d'essai sur PC
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Jeux de valeurs couvrant toute la plage de préfixes, mesure du
+//              temps et des cycles par opération (meilleure de plusieurs passes)
+//              et du nombre d'allocations sur le tas par appel. Résultats
+//              affichés en tableau et, sur demande, écrits en CSV pour servir
+//              de référence.
+
+#ifndef UNITY_BANC_H
+#define UNITY_BANC_H
+
+#include <Arduino.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace banc {
+
+// ============================================================================
+// JEUX DE VALEURS
+// ============================================================================
+
+static const size_t TAILLE_JEU = 256;
+
+struct Jeu {
+    const char* nom;
+    float valeurs[TAILLE_JEU];
+    size_t n;
+};
+
+/**
+ * Générateur pseudo-aléatoire déterministe (mêmes jeux à chaque exécution)
+ */
+inline uint32_t aleatoire() {
+    static uint32_t etat = 2463534242u;
+    etat ^= etat << 13;
+    etat ^= etat >> 17;
+    etat ^= etat << 5;
+    return etat;
+}
+
+/**
+ * Valeurs réparties sur toute la plage atto..téra (mantisse 1..999.999)
+ */
+inline void remplirPlage(Jeu& jeu, float signe) {
+    for (size_t i = 0; i < TAILLE_JEU; i++) {
+        int exposant = -18 + (int)(aleatoire() % 30);                 // 1e-18 .. 1e11
+        float mantisse = 1.0f + (float)(aleatoire() % 999000) / 1000.0f; // 1 .. 999.999
+        jeu.valeurs[i] = signe * mantisse * powf(10.0f, (float)exposant);
+    }
+    jeu.n = TAILLE_JEU;
+}
+
+/**
+ * Jeux standard : plage positive, plage négative, zéros, sous-epsilon
+ */
+inline size_t jeuxStandard(Jeu* jeux) {
+    jeux[0].nom = "atto..tera";
+    remplirPlage(jeux[0], 1.0f);
+
+    jeux[1].nom = "negatifs";
+    remplirPlage(jeux[1], -1.0f);
+
+    jeux[2].nom = "zero";
+    for (size_t i = 0; i < TAILLE_JEU; i++) jeux[2].valeurs[i] = (i & 1) ? -0.0f : 0.0f;
+    jeux[2].n = TAILLE_JEU;
+
+    // Sous le plus petit préfixe, jusqu'aux dénormalisés
+    jeux[3].nom = "sous-epsilon";
+    for (size_t i = 0; i < TAILLE_JEU; i++) {
+        int exposant = -40 + (int)(aleatoire() % 21);                  // 1e-40 .. 1e-20
+        jeux[3].valeurs[i] = (1.0f + (float)(aleatoire() % 1000) / 1000.0f) * powf(10.0f, (float)exposant);
+    }
+    jeux[3].n = TAILLE_JEU;
+
+    return 4;
+}
+
+// ============================================================================
+// MESURE
+// ============================================================================
+
+/**
+ * Compteur de cycles du processeur hôte (TSC sur x86, 0 ailleurs)
+ */
+inline uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static FILE* sortieCSV = nullptr;
+static volatile size_t puits = 0;  // Empêche le compilateur d'éliminer les appels
+
+/**
+ * Ouvre le fichier CSV si un nom est passé en argument (argv[1])
+ */
+inline void demarrer(const char* titre, int argc, char** argv) {
+    printf("%s\n", titre);
+    printf("%-40s %-14s %10s %10s %10s %10s\n", "fonction", "valeurs", "ns/op", "cycles/op", "alloc/op", "octets/op");
+    if (argc > 1) {
+        sortieCSV = fopen(argv[1], "w");
+        if (sortieCSV) fprintf(sortieCSV, "fonction,valeurs,ns_op,cycles_op,alloc_op,octets_op\n");
+        else fprintf(stderr, "Impossible d'ouvrir %s\n", argv[1]);
+    }
+}
+
+inline void terminer() {
+    if (sortieCSV) fclose(sortieCSV);
+    sortieCSV = nullptr;
+}
+
+/**
+ * Mesure f(val) sur toutes les valeurs du jeu.
+ * f renvoie une longueur (cumulée dans le puits) ; parAppel = nombre de valeurs
+ * traitées par appel de f (1, ou n pour les fonctions de lot).
+ */
+template <class Fonction>
+void mesurer(const char* nom, const Jeu& jeu, Fonction f, size_t parAppel = 1) {
+    using namespace std::chrono;
+    const size_t appels = jeu.n / parAppel;
+    const size_t operations = appels * parAppel;
+
+    // Allocations : une passe isolée, hors chronométrage
+    hote::CompteurTas avant = hote::compteurTas();
+    for (size_t i = 0; i < appels; i++) puits += f(jeu, i * parAppel);
+    hote::CompteurTas apres = hote::compteurTas();
+
+    // Temps : répétitions jusqu'à ~20 ms, meilleure de 5 passes
+    size_t repetitions = 1;
+    double meilleur = 1e30, meilleursCycles = 0;
+    for (int passe = 0; passe < 5; passe++) {
+        for (;;) {
+            steady_clock::time_point debut = steady_clock::now();
+            uint64_t cyclesDebut = cycles();
+            for (size_t r = 0; r < repetitions; r++)
+                for (size_t i = 0; i < appels; i++) puits += f(jeu, i * parAppel);
+            double nbCycles = (double)(cycles() - cyclesDebut);
+            double ns = (double)duration_cast<nanoseconds>(steady_clock::now() - debut).count();
+            if (ns < 2e7 && passe == 0) { repetitions *= 2; continue; }
+            double parOp = ns / (double)(repetitions * operations);
+            if (parOp < meilleur) {
+                meilleur = parOp;
+                meilleursCycles = nbCycles / (double)(repetitions * operations);
+            }
+            break;
+        }
+    }
+
+    double allocs = (double)(apres.allocations - avant.allocations) / (double)operations;
+    double octets = (double)(apres.octets - avant.octets) / (double)operations;
+    printf("%-40s %-14s %10.1f %10.0f %10.2f %10.1f\n", nom, jeu.nom, meilleur, meilleursCycles, allocs, octets);
+    if (sortieCSV) fprintf(sortieCSV, "%s,%s,%.2f,%.0f,%.3f,%.1f\n", nom, jeu.nom, meilleur, meilleursCycles, allocs, octets);
+}
+
+} // namespace banc
+
+#endif // UNITY_BANC_H
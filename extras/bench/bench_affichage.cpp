@@ -0,0 +1,155 @@
+// bench_affichage.cpp - Banc d'essai de l'affichage stable (texte mémorisé)
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Tableau de bord de six voies rafraîchi à 50 Hz, avec des
+//              relevés à 10 Hz de capteurs bruités et quantifiés par un CAN 12
+//              bits (alimentation, courant autour de 1 A, puissance,
+//              fréquence secteur, batterie, courant de veille autour de
+//              1 mA). Compare le formatage de chaque valeur à chaque trame à
+//              AffichageStable : temps CPU par trame, textes modifiés et
+//              changements de préfixe par trame. Vérifie que le texte
+//              mémorisé est celui de afficher() sans hystérésis.
+//              Usage : bench_affichage [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+static const size_t NB_TRAMES = banc::TAILLE_JEU;
+static const size_t TRAMES_PAR_RELEVE = 5;  // Écran à 50 Hz, capteurs lus à 10 Hz
+
+// Bruit gaussien approché (somme de 4 tirages uniformes), écart-type 1
+static double bruit() {
+    double s = 0;
+    for (int i = 0; i < 4; i++) s += (double)(banc::aleatoire() % 100001) / 100000.0 - 0.5;
+    return s * 1.732;
+}
+
+/**
+ * Une voie du tableau de bord : relevés de chaque trame et les trois façons
+ * de les afficher
+ */
+template <class G>
+struct Voie {
+    int nbDecimal;
+    float valeurs[NB_TRAMES];
+    char precedent[32];
+    AffichageStable<G> stable, sansHysteresis;
+    size_t changements, prefixes, longueurSymbole;
+    char dernierPrefixe;
+
+    // base + dérive sur la série, bruit d'écart-type bruit, pas du CAN lsb
+    Voie(int d, double base, double derive, double ecart, double lsb)
+        : nbDecimal(d), stable(d), sansHysteresis(d, 0.0f),
+          longueurSymbole(C_UNITY_BASE::longueurP(G::symbole())) {
+        for (size_t i = 0; i < NB_TRAMES; i++) {
+            double v = base + derive * (double)i / NB_TRAMES + ecart * bruit();
+            valeurs[i] = i % TRAMES_PAR_RELEVE ? valeurs[i - 1] : (float)(lsb * floor(v / lsb + 0.5));
+        }
+        precedent[0] = '\0';
+        compter();
+    }
+
+    void compter() {
+        changements = prefixes = 0;
+        dernierPrefixe = 0;
+    }
+
+    // Formatage à chaque trame ; redessin si le texte diffère du précédent
+    size_t formater(size_t i) {
+        char texte[32];
+        size_t n = G::afficher(texte, sizeof(texte), valeurs[i], nbDecimal);
+        if (strcmp(texte, precedent) == 0) return 0;
+        memcpy(precedent, texte, n + 1);
+        return n;
+    }
+
+    size_t memoriser(AffichageStable<G>& a, size_t i) {
+        a.texte(valeurs[i]);
+        return a.aChange() ? a.taille() : 0;
+    }
+
+    // Statistiques d'affichage d'une série : textes modifiés, préfixes changés
+    void suivre(AffichageStable<G>& a, size_t i) {
+        a.texte(valeurs[i]);
+        char p = a.texte()[a.taille() - longueurSymbole - 1];
+        if (p >= '0' && p <= '9') p = ' ';
+        if (a.aChange()) changements++;
+        if (dernierPrefixe && p != dernierPrefixe) prefixes++;
+        dernierPrefixe = p;
+    }
+
+    bool verifier() {
+        bool juste = true;
+        for (size_t tour = 0; tour < 3; tour++) {
+            for (size_t i = 0; i < NB_TRAMES; i++) {
+                char texte[32];
+                G::afficher(texte, sizeof(texte), valeurs[i], nbDecimal);
+                juste = juste && strcmp(texte, sansHysteresis.texte(valeurs[i])) == 0;
+            }
+        }
+        return juste;
+    }
+};
+
+int main(int argc, char** argv) {
+    Voie<Tension> alimentation(2, 12.0, 0.02, 0.004, 15.0 / 4096);
+    Voie<Courant> charge(3, 1.0, 0.0, 0.003, 2.0 / 4096);
+    Voie<Puissance> puissance(1, 11.8, 0.5, 0.05, 30.0 / 4096);
+    Voie<Frequence> secteur(2, 50.0, 0.0, 0.01, 0.001);
+    Voie<Tension> batterie(3, 3.71, -0.002, 0.0008, 5.0 / 4096);
+    Voie<Courant> veille(3, 1.0e-3, 0.0, 2.0e-6, 2.0e-3 / 4096);
+
+    bool juste = alimentation.verifier() && charge.verifier() && puissance.verifier()
+              && secteur.verifier() && batterie.verifier() && veille.verifier();
+    printf("Texte memorise = afficher() (sans hysteresis, 6 voies x %u trames x 3) : %s\n",
+           (unsigned)NB_TRAMES, juste ? "oui" : "NON");
+
+    // Textes modifiés et changements de préfixe sur la série, par voie
+    printf("%-28s %22s %22s\n", "", "sans hysteresis", "hysteresis 5 %");
+    printf("%-28s %10s %11s %10s %11s\n", "voie", "textes", "prefixes", "textes", "prefixes");
+#define SUIVRE(v, nom) do { \
+        size_t c[2], p[2]; \
+        v.compter(); v.sansHysteresis.effacer(); \
+        for (size_t i = 0; i < NB_TRAMES; i++) v.suivre(v.sansHysteresis, i); \
+        c[0] = v.changements; p[0] = v.prefixes; \
+        v.compter(); v.stable.effacer(); \
+        for (size_t i = 0; i < NB_TRAMES; i++) v.suivre(v.stable, i); \
+        c[1] = v.changements; p[1] = v.prefixes; \
+        printf("%-28s %10u %11u %10u %11u\n", nom, (unsigned)c[0], (unsigned)p[0], (unsigned)c[1], (unsigned)p[1]); \
+        juste = juste && p[1] <= p[0]; \
+    } while (0)
+    SUIVRE(alimentation, "alimentation 12 V");
+    SUIVRE(charge, "courant 1 A (mA / A)");
+    SUIVRE(puissance, "puissance 12 W");
+    SUIVRE(secteur, "frequence 50 Hz");
+    SUIVRE(batterie, "batterie 3.7 V");
+    SUIVRE(veille, "veille 1 mA (uA / mA)");
+#undef SUIVRE
+    printf("\n");
+
+    // Temps CPU par trame (six voies)
+    static Jeu jeu;
+    jeu.nom = "6 voies";
+    jeu.n = NB_TRAMES;
+    banc::demarrer("Tableau de bord (par trame)", argc, argv);
+    banc::mesurer("afficher(char*) a chaque trame", jeu, [&](const Jeu&, size_t i) {
+        return alimentation.formater(i) + charge.formater(i) + puissance.formater(i)
+             + secteur.formater(i) + batterie.formater(i) + veille.formater(i) + 1;
+    });
+    banc::mesurer("AffichageStable, sans hysteresis", jeu, [&](const Jeu&, size_t i) {
+        return alimentation.memoriser(alimentation.sansHysteresis, i) + charge.memoriser(charge.sansHysteresis, i)
+             + puissance.memoriser(puissance.sansHysteresis, i) + secteur.memoriser(secteur.sansHysteresis, i)
+             + batterie.memoriser(batterie.sansHysteresis, i) + veille.memoriser(veille.sansHysteresis, i) + 1;
+    });
+    banc::mesurer("AffichageStable, hysteresis 5 %", jeu, [&](const Jeu&, size_t i) {
+        return alimentation.memoriser(alimentation.stable, i) + charge.memoriser(charge.stable, i)
+             + puissance.memoriser(puissance.stable, i) + secteur.memoriser(secteur.stable, i)
+             + batterie.memoriser(batterie.stable, i) + veille.memoriser(veille.stable, i) + 1;
+    });
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
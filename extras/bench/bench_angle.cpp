@@ -0,0 +1,135 @@
+// bench_angle.cpp - Banc d'essai des conversions de température et d'angle
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Mesure l'erreur maximale de Angle::sinCosRapide et atan2Rapide
+//              contre sin, cos et atan2 en double, puis compare leur coût à
+//              sinf, cosf et atan2f de <math.h>. Compare aussi la conversion
+//              Celsius -> Kelvin et degrés -> radians valeur par valeur, par
+//              l'ancien stockage avec indicateur d'échelle, et par tableau.
+//              Usage : bench_angle [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+/**
+ * Stockage de la version 1.0.0 : valeur et indicateur d'échelle, testé à
+ * chaque lecture
+ */
+struct TemperatureIndicateur {
+    float valeur;
+    bool enKelvin;
+
+    operator float() const { return enKelvin ? valeur : valeur + (float)C_UNITY::KELVIN_OFFSET; }
+};
+
+static const float BORNE_SIN_COS = 1.2e-7f, BORNE_ATAN2 = 4e-7f;
+
+int main(int argc, char** argv) {
+    // Erreur maximale : 2 millions d'angles sur [-1e4, 1e4] rad
+    double erreurSin = 0, erreurCos = 0, erreurSinf = 0;
+    for (int32_t i = -1000000; i <= 1000000; i++) {
+        float x = (float)i * 1e-2f + (float)(banc::aleatoire() % 1000) * 1e-5f;
+        float s, c;
+        Angle::sinCosRapide(x, s, c);
+        erreurSin = fmax(erreurSin, fabs(s - sin((double)x)));
+        erreurCos = fmax(erreurCos, fabs(c - cos((double)x)));
+        erreurSinf = fmax(erreurSinf, fabs(sinf(x) - sin((double)x)));
+    }
+    // atan2 : points tirés dans les quatre quadrants, axes compris
+    double erreurAtan2 = 0, erreurAtan2f = 0;
+    for (int i = 0; i < 2000000; i++) {
+        float y = (float)((int32_t)(banc::aleatoire() % 2000001) - 1000000) * (i & 1 ? 1e-3f : 1.0f);
+        float x = (float)((int32_t)(banc::aleatoire() % 2000001) - 1000000) * (i & 2 ? 1e-3f : 1.0f);
+        if (i % 1000 == 0) y = 0.0f;
+        double ref = atan2((double)y, (double)x);
+        erreurAtan2 = fmax(erreurAtan2, fabs(Angle::atan2Rapide(y, x) - ref));
+        erreurAtan2f = fmax(erreurAtan2f, fabs(atan2f(y, x) - ref));
+    }
+    bool juste = erreurSin < BORNE_SIN_COS && erreurCos < BORNE_SIN_COS && erreurAtan2 < BORNE_ATAN2
+              && Angle::atan2Rapide(0.0f, 0.0f) == 0.0f;
+    printf("Erreur absolue maximale (reference double) :\n");
+    printf("  sinRapide  %.2e   cosRapide %.2e   (borne %.1e, sinf %.2e)\n", erreurSin, erreurCos, BORNE_SIN_COS, erreurSinf);
+    printf("  atan2Rapide %.2e  (borne %.1e, atan2f %.2e)\n", erreurAtan2, BORNE_ATAN2, erreurAtan2f);
+
+    // Stockage canonique : même valeur que l'ancien stockage avec indicateur
+    Temperature_KC t(25.0f, __Celsius__);
+    Angle a(180.0f, __Degres__);
+    juste = juste && (float)t == 298.15f && t.celsius() == "25.00°C" && a.degre() == "180.000°";
+    printf("Temperature_KC(25, Celsius) = %s = %s ; Angle(180, Degres) = %s\n",
+           t.kelvin().c_str(), t.celsius().c_str(), a.radian(5).c_str());
+    printf("Resultats %s\n\n", juste ? "justes" : "FAUX");
+
+    // Jeux : angles de -10 à 10 rad, températures de -40 à 85 °C
+    static Jeu jeu, ordonnees;
+    jeu.nom = "-10..10 rad";
+    ordonnees.nom = jeu.nom;
+    jeu.n = ordonnees.n = banc::TAILLE_JEU;
+    for (size_t i = 0; i < jeu.n; i++) {
+        jeu.valeurs[i] = (float)(banc::aleatoire() % 200001) * 1e-4f - 10.0f;
+        ordonnees.valeurs[i] = (float)(banc::aleatoire() % 200001) * 1e-4f - 10.0f;
+    }
+    static float sinus[banc::TAILLE_JEU], cosinus[banc::TAILLE_JEU], resultats[banc::TAILLE_JEU];
+    static TemperatureIndicateur anciennes[banc::TAILLE_JEU];
+    static Temperature_KC temperatures[banc::TAILLE_JEU];
+    for (size_t i = 0; i < jeu.n; i++) {
+        float celsius = 62.5f + 6.25f * jeu.valeurs[i];
+        anciennes[i].valeur = celsius;
+        anciennes[i].enKelvin = i & 1 ? false : true;
+        if (anciennes[i].enKelvin) anciennes[i].valeur = Temperature_KC::celsiusToKelvin(celsius);
+        temperatures[i] = Temperature_KC(anciennes[i].valeur, anciennes[i].enKelvin);
+    }
+
+    banc::demarrer("Temperature et angle (par valeur)", argc, argv);
+    banc::mesurer("stockage avec indicateur -> K", jeu, [&](const Jeu& e, size_t) {
+        for (size_t i = 0; i < e.n; i++) resultats[i] = anciennes[i];
+        return (size_t)(resultats[0] > 0);
+    }, jeu.n);
+    banc::mesurer("Temperature_KC -> K", jeu, [&](const Jeu& e, size_t) {
+        for (size_t i = 0; i < e.n; i++) resultats[i] = temperatures[i];
+        return (size_t)(resultats[0] > 0);
+    }, jeu.n);
+    banc::mesurer("celsiusToKelvin (tableau)", jeu, [&](const Jeu& e, size_t) {
+        Temperature_KC::celsiusToKelvin(e.valeurs, resultats, e.n);
+        return (size_t)(resultats[0] > 0);
+    }, jeu.n);
+    banc::mesurer("degresToRadians, valeur par valeur", jeu, [&](const Jeu& e, size_t i) {
+        resultats[i] = Angle(e.valeurs[i], __Degres__);
+        return (size_t)(resultats[i] > 0);
+    });
+    banc::mesurer("degresToRadians (tableau)", jeu, [&](const Jeu& e, size_t) {
+        Angle::degresToRadians(e.valeurs, resultats, e.n);
+        return (size_t)(resultats[0] > 0);
+    }, jeu.n);
+
+    banc::mesurer("sinf + cosf", jeu, [&](const Jeu& e, size_t i) {
+        sinus[i] = sinf(e.valeurs[i]);
+        cosinus[i] = cosf(e.valeurs[i]);
+        return (size_t)(sinus[i] > cosinus[i]);
+    });
+    banc::mesurer("sinCosRapide", jeu, [&](const Jeu& e, size_t i) {
+        Angle::sinCosRapide(e.valeurs[i], sinus[i], cosinus[i]);
+        return (size_t)(sinus[i] > cosinus[i]);
+    });
+    banc::mesurer("sinCosRapide (tableau)", jeu, [&](const Jeu& e, size_t) {
+        Angle::sinCosRapide(e.valeurs, sinus, cosinus, e.n);
+        return (size_t)(sinus[0] > cosinus[0]);
+    }, jeu.n);
+    banc::mesurer("atan2f", jeu, [&](const Jeu& e, size_t i) {
+        resultats[i] = atan2f(ordonnees.valeurs[i], e.valeurs[i]);
+        return (size_t)(resultats[i] > 0);
+    });
+    banc::mesurer("atan2Rapide", jeu, [&](const Jeu& e, size_t i) {
+        resultats[i] = Angle::atan2Rapide(ordonnees.valeurs[i], e.valeurs[i]);
+        return (size_t)(resultats[i] > 0);
+    });
+    banc::mesurer("atan2Rapide (tableau)", jeu, [&](const Jeu& e, size_t) {
+        Angle::atan2Rapide(ordonnees.valeurs, e.valeurs, resultats, e.n);
+        return (size_t)(resultats[0] > 0);
+    }, jeu.n);
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
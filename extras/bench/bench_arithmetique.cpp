@@ -0,0 +1,104 @@
+// bench_arithmetique.cpp - Banc d'essai des opérations sur les grandeurs
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Produit, quotient, somme et comparaison de grandeurs typées pour
+//              chaque représentation de la valeur (float, double, virgule fixe),
+//              et conversion d'unités (une valeur, un tableau). Vérifie les
+//              comparaisons entre unités d'une même dimension (kWh et J).
+//              Usage : bench_arithmetique [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+/**
+ * Mesure les opérations typées pour la représentation T.
+ * Les valeurs restent dans la plage de VirguleFixe<16> (tensions 0..30 V,
+ * courants 0..1 A) pour comparer les trois représentations sur le même jeu.
+ */
+template <class T>
+void mesurerRepresentation(const char* nom, const Jeu& jeu) {
+    typedef GrandeurEn<Tension, T> V;
+    typedef GrandeurEn<Courant, T> I;
+    typedef GrandeurEn<Puissance, T> P;
+    typedef GrandeurEn<Resistance, T> R;
+
+    static V tensions[banc::TAILLE_JEU];
+    static I courants[banc::TAILLE_JEU];
+    for (size_t i = 0; i < jeu.n; i++) {
+        tensions[i] = V(T(jeu.valeurs[i] * 30.0f));
+        courants[i] = I(T(jeu.valeurs[(i + 1) % jeu.n] + 0.001f));
+    }
+
+    char titre[64];
+    snprintf(titre, sizeof(titre), "%s : P = V * I", nom);
+    banc::mesurer(titre, jeu, [&](const Jeu&, size_t i) {
+        P p = tensions[i] * courants[i];
+        return (size_t)(p > P(T(1)));
+    });
+
+    snprintf(titre, sizeof(titre), "%s : R = V / I", nom);
+    banc::mesurer(titre, jeu, [&](const Jeu&, size_t i) {
+        R r = tensions[i] / courants[i];
+        return (size_t)(r < R(T(100)));
+    });
+
+    snprintf(titre, sizeof(titre), "%s : somme de tensions", nom);
+    banc::mesurer(titre, jeu, [&](const Jeu&, size_t i) {
+        static V total;
+        total += tensions[i];
+        return (size_t)(total >= tensions[0]);
+    });
+
+    snprintf(titre, sizeof(titre), "%s : afficher(char*)", nom);
+    banc::mesurer(titre, jeu, [&](const Jeu&, size_t i) {
+        char tampon[32];
+        return (tensions[i] * courants[i]).afficher(tampon, sizeof(tampon));
+    });
+}
+
+// Comparaisons entre unités de même dimension : faites dans l'unité commune
+static bool verifierComparaisons() {
+    bool juste = !(EnergieKWh(1) < Energie(1000)) && EnergieKWh(1) > Energie(1000)
+              && EnergieKWh(1) == Energie(3.6e6f) && Energie(3.6e6f) == EnergieKWh(1)
+              && Energie(3.7e6f) >= EnergieKWh(1) && Energie(3.5e6f) != EnergieKWh(1)
+              && PressionAtmospherique(1013.25f) == Pression(101325) && Pression(101324) < PressionAtmospherique(1013.25f)
+              && !(Tension(NAN) == Tension(NAN));
+    printf("Comparaisons entre unites : %s\n\n", juste ? "justes" : "FAUSSES");
+    return juste;
+}
+
+int main(int argc, char** argv) {
+    static Jeu jeu;
+    jeu.nom = "0..1";
+    for (size_t i = 0; i < banc::TAILLE_JEU; i++) jeu.valeurs[i] = (float)(banc::aleatoire() % 100000) / 100000.0f;
+    jeu.n = banc::TAILLE_JEU;
+    bool juste = verifierComparaisons();
+
+    banc::demarrer("Operations sur les grandeurs typees", argc, argv);
+    mesurerRepresentation<float>("float", jeu);
+    mesurerRepresentation<double>("double", jeu);
+    mesurerRepresentation<VirguleFixe<16> >("VirguleFixe<16>", jeu);
+
+    // Conversions d'unités : en deux temps par le pascal, puis directement
+    // (facteur calculé à la compilation), puis sur un tableau
+    static float mmHg[banc::TAILLE_JEU], hPa[banc::TAILLE_JEU];
+    for (size_t i = 0; i < jeu.n; i++) mmHg[i] = 700.0f + 100.0f * jeu.valeurs[i];
+    banc::mesurer("mmHg -> Pa -> hPa", jeu, [&](const Jeu&, size_t i) {
+        hPa[i] = convertir<PressionAtmospherique>(convertir<Pression>(Pression_mmHg(mmHg[i]))).getValeur();
+        return (size_t)(hPa[i] > 0);
+    });
+    banc::mesurer("convertir<PressionAtmospherique>(mmHg)", jeu, [&](const Jeu&, size_t i) {
+        hPa[i] = convertir<PressionAtmospherique>(Pression_mmHg(mmHg[i])).getValeur();
+        return (size_t)(hPa[i] > 0);
+    });
+    banc::mesurer("convertir<..., Pression_mmHg>(tableau)", jeu, [&](const Jeu& e, size_t) {
+        convertir<PressionAtmospherique, Pression_mmHg>(mmHg, hPa, e.n);
+        return (size_t)(hPa[0] > 0);
+    }, jeu.n);
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
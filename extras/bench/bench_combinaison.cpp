@@ -0,0 +1,116 @@
+// bench_combinaison.cpp - Banc d'essai de la recherche de combinaisons E6..E192
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Cherche la combinaison de 1 à 3 résistances normalisées la plus
+//              proche de cibles réparties de 10 Ω à 1 MΩ (gamme 1 Ω..9.88 MΩ).
+//              Vérifie RechercheE contre l'énumération exhaustive de tous les
+//              montages, puis mesure la latence d'une recherche par série et
+//              par nombre de composants, et la place occupée (flash, pile).
+//              Usage : bench_combinaison [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+/**
+ * Référence : tous les montages de 1 à nbMax valeurs de la gamme, O(N³)
+ */
+static double exhaustive(const RechercheE& r, double cible, int nbMax) {
+    const int n = r.taille();
+    double meilleur = 1e30;
+    for (int i = 0; i < n; i++) meilleur = fmin(meilleur, fabs(r.valeur(i) - cible));
+    for (int i = 0; i < n && nbMax >= 2; i++) {
+        for (int j = i; j < n; j++) {
+            double a = r.valeur(i), b = r.valeur(j);
+            double serie = a + b, parallele = 1.0 / (1.0 / a + 1.0 / b);
+            meilleur = fmin(meilleur, fmin(fabs(serie - cible), fabs(parallele - cible)));
+            for (int k = 0; k < n && nbMax >= 3; k++) {
+                double c = r.valeur(k);
+                meilleur = fmin(meilleur, fabs(serie + c - cible));
+                meilleur = fmin(meilleur, fabs(1.0 / (1.0 / a + 1.0 / b + 1.0 / c) - cible));
+                meilleur = fmin(meilleur, fabs(parallele + c - cible));
+                meilleur = fmin(meilleur, fabs(1.0 / (1.0 / serie + 1.0 / c) - cible));
+            }
+        }
+    }
+    return meilleur / cible;
+}
+
+// Cible tirée uniformément en décades entre 10^decadeMin et 10^(decadeMin + nbDecades)
+static float cible(int decadeMin, int nbDecades) {
+    return powf(10.0f, (float)decadeMin + (float)nbDecades * (float)(banc::aleatoire() % 100000) / 100000.0f);
+}
+
+int main(int argc, char** argv) {
+    // Exactitude : même écart que l'énumération exhaustive (E12, 100 Ω..98.8 kΩ)
+    RechercheE petite(SeriesE::E12, 2, 4);
+    size_t justes = 0;
+    const size_t NB_VERIFIEES = 200;
+    for (size_t i = 0; i < NB_VERIFIEES; i++) {
+        float t = cible(2, 3);
+        CombinaisonE c;
+        petite.chercher(t, 0.0f, 3, c);
+        double reference = exhaustive(petite, t, 3);
+        if (fabs(c.ecart) <= reference * 1.0001 + 1e-7) justes++;
+        else printf("Echec : %g (trouve %.3g, exhaustif %.3g)\n", t, fabs(c.ecart), reference);
+    }
+    printf("Recherche = enumeration exhaustive : %u / %u cibles\n", (unsigned)justes, (unsigned)NB_VERIFIEES);
+
+    // Durée de l'énumération exhaustive en E96 (une cible)
+    RechercheE e96(SeriesE::E96, 0, 6);
+    unsigned long debut = micros();
+    double reference = exhaustive(e96, 3140.7, 3);
+    printf("Enumeration exhaustive E96, 3 composants (%d valeurs) : %.0f ms (ecart %.2g)\n",
+           e96.taille(), (micros() - debut) / 1000.0, reference);
+
+    // Place occupée
+    printf("Tables en flash : %u octets (E24 + E192) ; RechercheE : %u octets de pile\n\n",
+           (unsigned)((SeriesE::E24 + SeriesE::E192) * sizeof(uint16_t)), (unsigned)sizeof(RechercheE));
+
+    // Latence : tolérance nulle (recherche complète) et 0.1 %
+    static Jeu jeu;
+    jeu.nom = "10 ohms..1 Mohms";
+    jeu.n = 32;  // Une recherche E192 à 3 composants dure quelques millisecondes
+    for (size_t i = 0; i < jeu.n; i++) jeu.valeurs[i] = cible(1, 5);
+
+    banc::demarrer("Recherche de combinaisons (par cible)", argc, argv);
+    struct Cas {
+        const char* nom;
+        uint8_t serie, nbMax;
+        float tolerance;
+    };
+    const Cas cas[] = {
+        { "E24, 1 composant",           SeriesE::E24,  1, 0.0f },
+        { "E24, 2 composants",          SeriesE::E24,  2, 0.0f },
+        { "E24, 3 composants",          SeriesE::E24,  3, 0.0f },
+        { "E96, 2 composants",          SeriesE::E96,  2, 0.0f },
+        { "E96, 3 composants",          SeriesE::E96,  3, 0.0f },
+        { "E96, 3 composants, 0.1 %",   SeriesE::E96,  3, 1e-3f },
+        { "E192, 3 composants",         SeriesE::E192, 3, 0.0f },
+    };
+    for (const Cas& c : cas) {
+        banc::mesurer(c.nom, jeu, [&](const Jeu& e, size_t i) {
+            CombinaisonE resultat;
+            Resistance::chercherCombinaison(e.valeurs[i], resultat, c.serie, c.tolerance, c.nbMax);
+            return (size_t)resultat.nombre;
+        });
+    }
+    banc::terminer();
+
+    // Quelques résultats
+    printf("\n");
+    for (size_t i = 0; i < 4; i++) {
+        CombinaisonE c;
+        Resistance::chercherCombinaison(jeu.valeurs[i], c, SeriesE::E96, 0.0f);
+        Serial.print(Resistance::afficher(jeu.valeurs[i], 4));
+        Serial.print(" = ");
+        c.afficher<Resistance>(Serial, 3);
+        Serial.print("  (ecart ");
+        Serial.print(c.ecart * 1e6f, 2);
+        Serial.println(" ppm)");
+    }
+    return justes != NB_VERIFIEES || banc::puits == 0;
+}
@@ -0,0 +1,117 @@
+// bench_compacte.cpp - Banc d'essai des grandeurs compactes sur 16 bits
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Erreur relative maximale de CodageLogSI et CodageDemi sur tous
+//              les float de leur plage (un sur 97), comparée à la borne
+//              annoncée ; aller-retour des codes ; coût du codage et du
+//              décodage par valeur, seule et par tableau, contre la copie
+//              d'un float ; place d'un historique de 400 mesures.
+//              Usage : bench_compacte [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+/**
+ * Plus grande erreur relative de l'aller-retour sur les float positifs de
+ * [debut, fin] (motifs binaires), par pas de 97
+ */
+template <class Codage>
+static double erreurMax(float debut, float fin, float& pire) {
+    uint32_t a, b;
+    memcpy(&a, &debut, sizeof(a));
+    memcpy(&b, &fin, sizeof(b));
+    double maxi = 0;
+    for (uint32_t x = a; x <= b; x += 97) {
+        float v;
+        memcpy(&v, &x, sizeof(v));
+        double e = fabs((double)Codage::decoder(Codage::coder(v)) - v) / v;
+        if (e > maxi) {
+            maxi = e;
+            pire = v;
+        }
+    }
+    return maxi;
+}
+
+template <class Codage>
+static bool verifier(const char* nom, float debut, float fin) {
+    float pire = 0;
+    double e = erreurMax<Codage>(debut, fin, pire);
+    bool juste = e <= Codage::erreurRelative();
+    printf("%-12s %9.3g .. %-9.3g erreur max %.4f %% (a %.4g), borne %.4f %%  %s\n", nom, debut, fin, e * 100, pire,
+           Codage::erreurRelative() * 100, juste ? "juste" : "FAUX");
+    return juste;
+}
+
+int main(int argc, char** argv) {
+    bool juste = verifier<CodageLogSI>("CodageLogSI", 1.0034e-18f, 9.93e29f);
+    juste = verifier<CodageDemi>("CodageDemi", 6.1035e-5f, 65504.0f) && juste;
+
+    // Codes logarithmiques : chaque code se relit en lui-même, valeurs croissantes
+    bool croissants = true;
+    for (uint16_t c = 1; c < CodageLogSI::INVALIDE; c++) {
+        croissants = croissants && CodageLogSI::coder(CodageLogSI::decoder(c)) == c
+                                && (c == 1 || CodageLogSI::decoder(c - 1) < CodageLogSI::decoder(c));
+    }
+    juste = juste && croissants;
+    printf("CodageLogSI : %u codes stables et croissants : %s\n", (unsigned)CodageLogSI::INVALIDE - 1,
+           croissants ? "oui" : "NON");
+
+    GrandeurCompacte<Capacite> c = Capacite(4.7e-9f);
+    GrandeurCompacte<Tension, CodageDemi> u = Tension(230.4f);
+    c.afficher(Serial);
+    u.afficher(Serial);
+    printf("\nHistorique de 400 mesures : %u octets (float : %u)\n\n",
+           (unsigned)(400 * sizeof(GrandeurCompacte<Tension>)), (unsigned)(400 * sizeof(Tension)));
+
+    static Jeu jeux[2];
+    jeux[0].nom = "atto..tera";
+    banc::remplirPlage(jeux[0], 1.0f);
+    jeux[1].nom = "secteur";
+    jeux[1].n = banc::TAILLE_JEU;
+    for (size_t i = 0; i < banc::TAILLE_JEU; i++) jeux[1].valeurs[i] = 230.0f + (float)(banc::aleatoire() % 2001) / 100.0f - 10.0f;
+
+    static float copies[banc::TAILLE_JEU];
+    static GrandeurCompacte<Tension> logs[banc::TAILLE_JEU];
+    static GrandeurCompacte<Tension, CodageDemi> demis[banc::TAILLE_JEU];
+
+    banc::demarrer("Grandeurs compactes (par valeur)", argc, argv);
+    for (const Jeu& jeu : jeux) {
+        GrandeurCompacte<Tension>::coder(jeu.valeurs, logs, jeu.n);
+        GrandeurCompacte<Tension, CodageDemi>::coder(jeu.valeurs, demis, jeu.n);
+        banc::mesurer("float : copie", jeu, [&](const Jeu& e, size_t i) {
+            copies[i] = e.valeurs[i];
+            return (size_t)1;
+        });
+        banc::mesurer("CodageLogSI::coder", jeu, [&](const Jeu& e, size_t i) {
+            logs[i] = Tension(e.valeurs[i]);
+            return (size_t)(logs[i].brut() != 0);
+        });
+        banc::mesurer("CodageLogSI::decoder", jeu, [&](const Jeu&, size_t i) {
+            copies[i] = Tension(logs[i]).getValeur();
+            return (size_t)(copies[i] != 0);
+        });
+        banc::mesurer("CodageLogSI : tableau decode", jeu, [&](const Jeu& e, size_t) {
+            GrandeurCompacte<Tension>::decoder(logs, copies, e.n);
+            return (size_t)(copies[0] != 0);
+        }, jeu.n);
+        banc::mesurer("CodageDemi::coder", jeu, [&](const Jeu& e, size_t i) {
+            demis[i] = Tension(e.valeurs[i]);
+            return (size_t)(demis[i].brut() != 0);
+        });
+        banc::mesurer("CodageDemi::decoder", jeu, [&](const Jeu&, size_t i) {
+            copies[i] = Tension(demis[i]).getValeur();
+            return (size_t)(copies[i] == copies[i]);
+        });
+        banc::mesurer("CodageDemi : tableau decode", jeu, [&](const Jeu& e, size_t) {
+            GrandeurCompacte<Tension, CodageDemi>::decoder(demis, copies, e.n);
+            return (size_t)1;
+        }, jeu.n);
+    }
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
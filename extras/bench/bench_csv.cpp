@@ -0,0 +1,133 @@
+// bench_csv.cpp - Banc d'essai de la mise en forme de journaux CSV
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Journal synthétique d'un compteur d'énergie (horodatage,
+//              tension, courant, puissance, fréquence, index en Wh), mis en
+//              forme par csv::FormateurCSV (l'outil unity_csv) avec 1 à N
+//              threads : débit en Mo/s lus, accélération par rapport à un
+//              thread, sortie identique quel que soit le nombre de threads.
+//              Comparé à la boucle écrite à la main : strtof puis
+//              valeurAvecUnite en String, ligne par ligne.
+//              Usage : bench_csv [taille en Mo]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "formateur_csv.h"
+#include <chrono>
+
+static const char* COLONNES = "-,V,A,W,Hz,#";
+
+static void genererJournal(std::vector<char>& journal, size_t taille) {
+    char ligne[128];
+    journal.reserve(taille + sizeof(ligne));
+    uint32_t etat = 2463534242u;
+    for (uint32_t i = 0; journal.size() < taille; i++) {
+        etat ^= etat << 13;
+        etat ^= etat >> 17;
+        etat ^= etat << 5;
+        float u = 230.0f + (float)(etat % 2001) / 100.0f - 10.0f;
+        float courant = (float)(etat % 16000) / 1000.0f + 0.001f;
+        float f = 49.95f + (float)(etat % 101) / 1000.0f;
+        int n = snprintf(ligne, sizeof(ligne), "%u,%.2f,%.4f,%.1f,%.3f,%u\n", 1700000000u + i, u, courant,
+                         u * courant, f, 1000000u + i * 3u);
+        journal.insert(journal.end(), ligne, ligne + n);
+    }
+}
+
+// Empreinte FNV-1a de la sortie, dans l'ordre d'écriture
+struct Empreinte {
+    uint64_t h = 1469598103934665603ull;
+    size_t octets = 0;
+
+    void ajouter(const char* p, size_t n) {
+        for (size_t i = 0; i < n; i++) h = (h ^ (uint8_t)p[i]) * 1099511628211ull;
+        octets += n;
+    }
+};
+
+/**
+ * Ce que l'on écrit à la main : champ par champ, strtof puis
+ * valeurAvecUnite (String) ou formatNombre (String)
+ */
+static size_t aLaMain(const char* p, const char* fin) {
+    static const char* const symboles[] = { nullptr, "V", "A", "W", "Hz", nullptr };
+    size_t octets = 0;
+    String ligne;
+    while (p < fin) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', (size_t)(fin - p)));
+        if (!eol) eol = fin;
+        ligne = "";
+        int colonne = 0;
+        for (const char* c = p; c < eol; colonne++) {
+            const char* f = static_cast<const char*>(memchr(c, ',', (size_t)(eol - c)));
+            if (!f) f = eol;
+            char champ[64];
+            size_t n = (size_t)(f - c) < sizeof(champ) - 1 ? (size_t)(f - c) : sizeof(champ) - 1;
+            memcpy(champ, c, n);
+            champ[n] = '\0';
+            if (colonne > 0) ligne += ",";
+            if (colonne == 0) ligne += champ;
+            else if (colonne == 5) ligne += C_UNITY_BASE::formatNombre(strtof(champ, nullptr));
+            else ligne += C_UNITY_BASE::valeurAvecUnite(strtof(champ, nullptr), symboles[colonne]);
+            c = f + 1;
+        }
+        ligne += "\n";
+        octets += ligne.length();
+        p = eol + 1;
+    }
+    return octets;
+}
+
+int main(int argc, char** argv) {
+    size_t mo = argc > 1 ? (size_t)atol(argv[1]) : 32;
+    std::vector<char> journal;
+    genererJournal(journal, mo * 1000000);
+    const char* donnees = &journal[0];
+    const size_t taille = journal.size();
+    unsigned coeurs = std::thread::hardware_concurrency();
+    printf("Journal de %.1f Mo (%s), %u coeurs\n\n", taille / 1e6, COLONNES, coeurs);
+
+    csv::FormateurCSV formateur;
+    formateur.colonnes(COLONNES);
+    csv::SortieBloc exemple;
+    const char* finLigne = static_cast<const char*>(memchr(donnees, '\n', taille)) + 1;
+    formateur.formater(donnees, finLigne, exemple);
+    printf("%.*s%.*s\n", (int)(finLigne - donnees), donnees, (int)exemple.taille(), exemple.donnees());
+
+    printf("%-34s %10s %10s %10s\n", "mise en forme", "Mo/s", "x 1 thread", "sortie");
+    auto debut = std::chrono::steady_clock::now();
+    size_t octets = aLaMain(donnees, donnees + taille);
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+    printf("%-34s %10.1f %10s %9.1fM\n", "a la main (strtof + String)", taille / 1e6 / s, "", octets / 1e6);
+
+    // 1, 2, 4... threads jusqu'au double du nombre de cœurs
+    bool juste = true;
+    double reference = 0;
+    Empreinte attendue;
+    unsigned limite = coeurs > 1 ? 2 * coeurs : 4;
+    for (unsigned threads = 1; threads <= limite; threads *= 2) {
+        Empreinte e;
+        debut = std::chrono::steady_clock::now();
+        formateur.traiter(donnees, taille, threads, [&](const char* p, size_t n) { e.ajouter(p, n); });
+        s = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+        if (threads == 1) {
+            reference = s;
+            attendue = e;
+        }
+        bool identique = e.h == attendue.h && e.octets == attendue.octets;
+        juste = juste && identique;
+        char nom[48];
+        snprintf(nom, sizeof(nom), "FormateurCSV, %u thread%s", threads, threads > 1 ? "s" : "");
+        printf("%-34s %10.1f %10.2f %9.1fM %s\n", nom, taille / 1e6 / s, reference / s, e.octets / 1e6,
+               identique ? "" : "DIFFERENTE");
+    }
+
+    // Petits blocs : découpage et ordre de sortie
+    formateur.tailleBloc = 4096;
+    Empreinte e;
+    formateur.traiter(donnees, taille, 3, [&](const char* p, size_t n) { e.ajouter(p, n); });
+    juste = juste && e.h == attendue.h && e.octets == attendue.octets;
+    printf("Blocs de 4 ko, 3 threads : sortie %s\n", e.h == attendue.h ? "identique" : "DIFFERENTE");
+    return !juste;
+}
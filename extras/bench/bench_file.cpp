@@ -0,0 +1,173 @@
+// bench_file.cpp - Banc d'essai de la file de mesures sans verrou
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Un thread producteur (l'interruption d'acquisition) et un
+//              thread consommateur (loop) échangent des courants numérotés
+//              par FileMesures<Courant, N>. Épreuve d'endurance : sans perte
+//              quand le producteur attend, puis avec pertes comptées quand il
+//              n'attend pas (reçues + pertes = envoyées, ordre conservé).
+//              Débit entre threads, mesure par mesure et par lots, comparé à
+//              une file protégée par un mutex ; coût d'un ajout et d'un
+//              retrait dans un seul thread.
+//              Usage : bench_file [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using banc::Jeu;
+
+// Numéros exacts en float jusqu'à 2^24
+static const uint32_t NB_MESURES = 2000000;
+
+/**
+ * Ce que l'on écrit sans FileMesures : tableau circulaire sous mutex
+ * (l'équivalent de noInterrupts() / interrupts() autour de chaque accès)
+ */
+template <size_t N>
+class FileMutex {
+public:
+    bool ajouter(float val) {
+        std::lock_guard<std::mutex> verrou(m);
+        if (n == N) return false;
+        mesures[(debut + n++) % N] = val;
+        return true;
+    }
+
+    size_t retirer(float* vals, size_t nbMax) {
+        std::lock_guard<std::mutex> verrou(m);
+        size_t a = n < nbMax ? n : nbMax;
+        for (size_t i = 0; i < a; i++) vals[i] = mesures[(debut + i) % N];
+        debut = (debut + a) % N;
+        n -= a;
+        return a;
+    }
+
+private:
+    std::mutex m;
+    float mesures[N];
+    size_t debut = 0, n = 0;
+};
+
+struct Bilan {
+    uint32_t recues, pertes;
+    bool ordre;
+    double nsParMesure;
+};
+
+/**
+ * Le producteur envoie 0, 1, 2... (en attendant une place si attendre) ; le
+ * consommateur retire par lots de taille lot et vérifie que les numéros
+ * reçus croissent (strictement consécutifs s'il n'y a pas de perte)
+ */
+template <class F>
+static Bilan echanger(F& file, size_t lot, bool attendre) {
+    Bilan b = { 0, 0, true, 0 };
+    volatile bool fini = false;
+    auto debut = std::chrono::steady_clock::now();
+    std::thread producteur([&] {
+        for (uint32_t i = 0; i < NB_MESURES; i++) {
+            while (!file.ajouter((float)i)) {
+                if (!attendre) {
+                    b.pertes++;
+                    break;
+                }
+                std::this_thread::yield();  // Place au consommateur (une seule unité de calcul)
+            }
+        }
+        __atomic_store_n(&fini, true, __ATOMIC_RELEASE);
+    });
+    std::thread consommateur([&] {
+        float vals[256];
+        float attendu = 0;
+        for (;;) {
+            bool dernier = __atomic_load_n(&fini, __ATOMIC_ACQUIRE);
+            size_t n = file.retirer(vals, lot);
+            for (size_t i = 0; i < n; i++) {
+                if (attendre ? vals[i] != attendu : vals[i] < attendu) b.ordre = false;
+                attendu = vals[i] + 1;
+            }
+            b.recues += (uint32_t)n;
+            if (n == 0) {
+                if (dernier) break;  // Plus rien après la fin du producteur
+                std::this_thread::yield();
+            }
+        }
+    });
+    producteur.join();
+    consommateur.join();
+    b.nsParMesure = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - debut).count() / NB_MESURES;
+    return b;
+}
+
+static bool afficherBilan(const char* nom, const Bilan& b, bool attendre, uint32_t pertesFile) {
+    bool juste = b.ordre && b.recues + b.pertes == NB_MESURES && (!attendre || b.pertes == 0) && pertesFile == b.pertes;
+    printf("%-34s %9u recues %9u pertes  %6.1f ns/mesure  %s\n", nom, (unsigned)b.recues, (unsigned)b.pertes,
+           b.nsParMesure, juste ? "juste" : "FAUX");
+    return juste;
+}
+
+template <size_t N>
+static bool essai(const char* nom, size_t lot, bool attendre) {
+    static FileMesures<Courant, N> file;
+    file = FileMesures<Courant, N>();
+    Bilan b = echanger(file, lot, attendre);
+    return afficherBilan(nom, b, attendre, attendre ? 0 : file.pertes());
+}
+
+int main(int argc, char** argv) {
+    printf("%u mesures numerotees, un producteur et un consommateur\n", (unsigned)NB_MESURES);
+    bool juste = essai<256>("FileMesures<256>, mesure par mesure", 1, true);
+    juste = essai<256>("FileMesures<256>, lots de 32", 32, true) && juste;
+    juste = essai<4096>("FileMesures<4096>, lots de 256", 256, true) && juste;
+    juste = essai<256>("FileMesures<256>, sans attente", 32, false) && juste;
+    juste = essai<16>("FileMesures<16>, sans attente", 1, false) && juste;
+    static FileMutex<256> verrou;
+    Bilan b = echanger(verrou, 1, true);
+    juste = afficherBilan("mutex, mesure par mesure", b, true, 0) && juste;
+    b = echanger(verrou, 32, true);
+    juste = afficherBilan("mutex, lots de 32", b, true, 0) && juste;
+
+    // Remplissage maximal et pertes vus par le consommateur
+    FileMesures<Courant, 8> petite;
+    for (int i = 0; i < 10; i++) petite.ajouter(Courant(i * 1e-3f));
+    Courant c;
+    petite.retirer(c);
+    juste = juste && petite.niveauMax() == 7 && petite.pertes() == 3 && c.getValeur() == 0.0f && petite.taille() == 6;
+    printf("FileMesures<Courant, 8> : %u places, niveau max %u, %u pertes, %u octets (%u sur AVR)\n\n",
+           (unsigned)petite.capacite(), (unsigned)petite.niveauMax(), (unsigned)petite.pertes(),
+           (unsigned)sizeof(petite), (unsigned)(8 * 4 + 3 + 4));
+
+    // Coût dans un seul thread (ajout puis retrait, sans concurrence)
+    static Jeu jeu;
+    jeu.nom = "courants";
+    jeu.n = banc::TAILLE_JEU;
+    for (size_t i = 0; i < jeu.n; i++) jeu.valeurs[i] = (float)(banc::aleatoire() % 20000) * 1e-3f;
+    static FileMesures<Courant, 256> file;
+    static FileMutex<256> fileMutex;
+    static float sortie[banc::TAILLE_JEU];
+
+    banc::demarrer("File de mesures (ajout + retrait, par mesure)", argc, argv);
+    banc::mesurer("FileMesures : ajouter / retirer", jeu, [&](const Jeu& e, size_t i) {
+        float v;
+        file.ajouter(e.valeurs[i]);
+        file.retirer(v);
+        return (size_t)(v >= 0);
+    });
+    banc::mesurer("FileMesures : lots de 255", jeu, [&](const Jeu& e, size_t) {
+        size_t n = file.ajouter(e.valeurs, 255);
+        return file.retirer(sortie, n);
+    }, 255);
+    banc::mesurer("mutex : ajouter / retirer", jeu, [&](const Jeu& e, size_t i) {
+        float v;
+        fileMutex.ajouter(e.valeurs[i]);
+        fileMutex.retirer(&v, 1);
+        return (size_t)(v >= 0);
+    });
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
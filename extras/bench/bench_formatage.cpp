@@ -0,0 +1,228 @@
+// bench_formatage.cpp - Banc d'essai du formatage (chemin critique de l'affichage)
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Mesure chaque point d'entrée public de formatage sur les jeux
+//              atto..téra, négatifs, zéro et sous-epsilon : temps par valeur et
+//              allocations sur le tas par valeur, en float, double et virgule
+//              fixe. La version 1.0.0 (historique) sert de référence : les
+//              sorties String de valeurAvecUnite et formatNombre doivent lui
+//              être identiques.
+//              Usage : bench_formatage [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+#include "historique.h"
+
+using banc::Jeu;
+
+typedef VirguleFixe<16> Fixe;
+
+static const size_t CAP = 64;
+static const size_t TAILLE_LOT = 16;
+
+// Conversion d'un jeu vers la virgule fixe, saturée à sa plage (±32767)
+static void versFixe(const Jeu& jeu, Fixe* sortie) {
+    for (size_t i = 0; i < jeu.n; i++) {
+        float v = jeu.valeurs[i];
+        sortie[i] = Fixe(v > 32767.0f ? 32767.0f : v < -32767.0f ? -32767.0f : v);
+    }
+}
+
+// Retenue vers le préfixe suivant (1.000k au lieu de 1000.000), seul écart voulu avec la 1.0.0
+static bool retenue(const String& ancien) {
+    const char* p = ancien.c_str();
+    while (*p == ' ' || *p == '-') p++;
+    return strncmp(p, "1000", 4) == 0 && (p[4] < '0' || p[4] > '9');
+}
+
+/**
+ * Sortie String de valeurAvecUnite identique à la version 1.0.0 : jeux
+ * standard, cas limites d'arrondi, au-delà du téra, nan et inf, et un
+ * motif binaire de float sur 262139, de 0 à 6 décimales
+ */
+static bool verifierHistorique(const Jeu* jeux, size_t nbJeux) {
+    static const float limites[] = { 0.000999f, 0.99949f, 9.995f, 999.9996f, 1.0f, 0.0f, -0.0f,
+                                     5e22f, -3.4e38f, 1e-19f, 1e12f, 999.5f, 2.5f, 0.125f,
+                                     NAN, -NAN, INFINITY, -INFINITY };
+    size_t comparees = 0, ecarts = 0;
+    auto comparer = [&](float v) {
+        for (int d = 0; d <= 6; d++) {
+            String ancien = historique::valeurAvecUnite(v, "V", d);
+            if (retenue(ancien)) continue;
+            String nouveau = C_UNITY::valeurAvecUnite(v, String("V"), d);
+            comparees++;
+            if (ancien == nouveau) continue;
+            if (ecarts++ < 5) printf("  %.9g, %d : 1.0.0 \"%s\", actuel \"%s\"\n", v, d, ancien.c_str(), nouveau.c_str());
+        }
+    };
+    for (float v : limites) comparer(v);
+    for (size_t j = 0; j < nbJeux; j++) {
+        for (size_t i = 0; i < jeux[j].n; i++) comparer(jeux[j].valeurs[i]);
+    }
+    for (uint64_t x = 0; x <= 0xFFFFFFFFULL; x += 262139) {
+        uint32_t bits = (uint32_t)x;
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        comparer(v);
+    }
+#ifdef UNITY_FORMATAGE_ENTIER
+    // Moteur entier : produit exact par le facteur float de la table, et non par
+    // la constante double de la 1.0.0 ; les derniers chiffres peuvent différer
+    printf("valeurAvecUnite(String) identique a la 1.0.0 : %u / %u sorties (moteur entier, indicatif)\n\n",
+           (unsigned)(comparees - ecarts), (unsigned)comparees);
+    return true;
+#else
+    printf("valeurAvecUnite(String) identique a la 1.0.0 : %u / %u sorties%s\n\n",
+           (unsigned)(comparees - ecarts), (unsigned)comparees, ecarts ? "  FAUX" : "");
+    return ecarts == 0;
+#endif
+}
+
+/**
+ * Sortie String de formatNombre identique à la version 1.0.0 (largeur de
+ * dtostrf comprise) sur les mêmes valeurs, de 0 à 6 décimales
+ */
+static bool verifierFormatNombre(const Jeu* jeux, size_t nbJeux) {
+    static const float limites[] = { 0.0f, -0.0f, 5.0f, -5.0f, 0.5f, 1.5f, 2.5f, 999.5f, 1234567.89f,
+                                      -1234.5f, 4294967295.0f, 1e19f, -3.4e38f, 1e-19f,
+                                      NAN, -NAN, INFINITY, -INFINITY };
+    size_t comparees = 0, ecarts = 0;
+    auto comparer = [&](float v) {
+        for (int d = 0; d <= 6; d++) {
+            // La 1.0.0 insérait aussi le séparateur dans les espaces de tête ("  ,nan")
+            String brut = historique::formatNombre(v, d, ',');
+            String ancien;
+            size_t tete = 0;
+            for (; tete < brut.length() && (brut[tete] == ' ' || brut[tete] == ','); tete++) {
+                if (brut[tete] == ' ') ancien += ' ';
+            }
+            ancien += brut.substring(tete);
+            String nouveau = C_UNITY::formatNombre(v, d, ',');
+            comparees++;
+            if (ancien == nouveau) continue;
+            if (ecarts++ < 5) printf("  %.9g, %d : 1.0.0 \"%s\", actuel \"%s\"\n", v, d, ancien.c_str(), nouveau.c_str());
+        }
+    };
+    for (float v : limites) comparer(v);
+    for (size_t j = 0; j < nbJeux; j++) {
+        for (size_t i = 0; i < jeux[j].n; i++) comparer(jeux[j].valeurs[i]);
+    }
+    for (uint64_t x = 0; x <= 0xFFFFFFFFULL; x += 262139) {
+        uint32_t bits = (uint32_t)x;
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        comparer(v);
+    }
+    printf("formatNombre(String) identique a la 1.0.0 : %u / %u sorties%s\n\n",
+           (unsigned)(comparees - ecarts), (unsigned)comparees, ecarts ? "  FAUX" : "");
+    return ecarts == 0;
+}
+
+int main(int argc, char** argv) {
+    static Jeu jeux[4];
+    size_t nbJeux = banc::jeuxStandard(jeux);
+    bool juste = verifierHistorique(jeux, nbJeux);
+    juste = verifierFormatNombre(jeux, nbJeux) && juste;
+    static char tampon[CAP * TAILLE_LOT];
+    const String uniteRAM = "V";
+
+    banc::demarrer("Formatage des valeurs avec unite", argc, argv);
+
+    for (size_t j = 0; j < nbJeux; j++) {
+        const Jeu& jeu = jeux[j];
+        static double doubles[banc::TAILLE_JEU];
+        static Fixe fixes[banc::TAILLE_JEU];
+        for (size_t i = 0; i < jeu.n; i++) doubles[i] = jeu.valeurs[i];
+        versFixe(jeu, fixes);
+
+        banc::mesurer("historique::valeurAvecUnite(String)", jeu, [&](const Jeu& e, size_t i) {
+            return (size_t)historique::valeurAvecUnite(e.valeurs[i], uniteRAM).length();
+        });
+        banc::mesurer("valeurAvecUnite(float, String)", jeu, [&](const Jeu& e, size_t i) {
+            return (size_t)C_UNITY::valeurAvecUnite(e.valeurs[i], uniteRAM).length();
+        });
+        banc::mesurer("valeurAvecUnite(float, F())", jeu, [&](const Jeu& e, size_t i) {
+            return (size_t)C_UNITY::valeurAvecUnite(e.valeurs[i], F("V")).length();
+        });
+        banc::mesurer("valeurAvecUnite(char*, const char*)", jeu, [&](const Jeu& e, size_t i) {
+            return C_UNITY::valeurAvecUnite(tampon, CAP, e.valeurs[i], "V");
+        });
+        banc::mesurer("valeurAvecUnite(char*, F())", jeu, [&](const Jeu& e, size_t i) {
+            return C_UNITY::valeurAvecUnite(tampon, CAP, e.valeurs[i], F("V"));
+        });
+        banc::mesurer("C_UNITY::valeurAvecUnite(char*) instance", jeu, [&](const Jeu& e, size_t i) {
+            C_UNITY u(e.valeurs[i]);
+            return u.valeurAvecUnite(tampon, CAP, "V");
+        });
+        banc::mesurer("valeursAvecUnite(lot de 16)", jeu, [&](const Jeu& e, size_t i) {
+            return C_UNITY::valeursAvecUnite(tampon, sizeof(tampon), e.valeurs + i, TAILLE_LOT, F("V"));
+        }, TAILLE_LOT);
+        banc::mesurer("Tension::afficher() String", jeu, [&](const Jeu& e, size_t i) {
+            Tension v(e.valeurs[i]);
+            return (size_t)v.afficher().length();
+        });
+        banc::mesurer("Tension::afficher(char*)", jeu, [&](const Jeu& e, size_t i) {
+            Tension v(e.valeurs[i]);
+            return v.afficher(tampon, CAP);
+        });
+        banc::mesurer("Resistance::afficher(char*, lot de 16)", jeu, [&](const Jeu& e, size_t i) {
+            return Resistance::afficher(tampon, sizeof(tampon), e.valeurs + i, TAILLE_LOT);
+        }, TAILLE_LOT);
+        // Autres représentations de la valeur (C_UNITY_T<double>, VirguleFixe)
+        banc::mesurer("valeurAvecUnite(char*, double)", jeu, [&](const Jeu&, size_t i) {
+            return C_UNITY::valeurAvecUnite(tampon, CAP, doubles[i], "V");
+        });
+        banc::mesurer("valeurAvecUnite(char*, VirguleFixe<16>)", jeu, [&](const Jeu&, size_t i) {
+            return C_UNITY::valeurAvecUnite(tampon, CAP, fixes[i], "V");
+        });
+        banc::mesurer("valeursAvecUnite(double, lot de 16)", jeu, [&](const Jeu&, size_t i) {
+            return C_UNITY::valeursAvecUnite(tampon, sizeof(tampon), doubles + i, TAILLE_LOT, F("V"));
+        }, TAILLE_LOT);
+        banc::mesurer("valeursAvecUnite(fixe, lot de 16)", jeu, [&](const Jeu&, size_t i) {
+            return C_UNITY::valeursAvecUnite(tampon, sizeof(tampon), fixes + i, TAILLE_LOT, F("V"));
+        }, TAILLE_LOT);
+        banc::mesurer("formatNombre(double, 2)", jeu, [&](const Jeu&, size_t i) {
+            return (size_t)C_UNITY::formatNombre(doubles[i], 2).length();
+        });
+
+        // Les deux moteurs de formatage, quel que soit celui choisi à la compilation
+        banc::mesurer("ecrireMesureFlottante (moteur float)", jeu, [&](const Jeu& e, size_t i) -> size_t {
+            float val = fabsf(e.valeurs[i]);
+            int indice = C_UNITY::indicePrefixe(val);
+            if (val == 0.0f || indice < 0) return (size_t)0;
+            C_UNITY::Tampon t(tampon, CAP);
+            C_UNITY::ecrireMesureFlottante(t, val, indice, 3);
+            return t.terminer();
+        });
+        banc::mesurer("ecrireMesureEntiere (moteur entier)", jeu, [&](const Jeu& e, size_t i) -> size_t {
+            float val = fabsf(e.valeurs[i]);
+            int indice = C_UNITY::indicePrefixe(val);
+            if (val == 0.0f || indice < 0) return (size_t)0;
+            C_UNITY::Tampon t(tampon, CAP);
+            C_UNITY::ecrireMesureEntiere(t, val, indice, 3);
+            return t.terminer();
+        });
+        // Séparateur de milliers : 1.0.0 (dtostrf + insertion), String et tampon
+        banc::mesurer("historique::formatNombre(float, 2)", jeu, [&](const Jeu& e, size_t i) {
+            return (size_t)historique::formatNombre(e.valeurs[i], 2).length();
+        });
+        banc::mesurer("formatNombre(float, 2)", jeu, [&](const Jeu& e, size_t i) {
+            return (size_t)C_UNITY::formatNombre(e.valeurs[i], 2).length();
+        });
+        banc::mesurer("formatNombre(char*, float, 2)", jeu, [&](const Jeu& e, size_t i) {
+            return C_UNITY::formatNombre(tampon, CAP, e.valeurs[i], 2);
+        });
+        banc::mesurer("formatNombre(char*, double, 2, U+202F)", jeu, [&](const Jeu&, size_t i) {
+            return C_UNITY::formatNombre(tampon, CAP, doubles[i], 2, "\xE2\x80\xAF");
+        });
+        banc::mesurer("formatNombre(char*, VirguleFixe<16>, 2)", jeu, [&](const Jeu&, size_t i) {
+            return C_UNITY::formatNombre(tampon, CAP, fixes[i], 2);
+        });
+        printf("\n");
+    }
+
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
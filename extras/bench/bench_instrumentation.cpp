@@ -0,0 +1,93 @@
+// bench_instrumentation.cpp - Banc d'essai de l'instrumentation des points d'entrée
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Rejoue une boucle de rapport (String, tampon, Print, lots,
+//              formatNombre) puis mesure le coût par appel de chaque point
+//              d'entrée. Compilé deux fois : bench_instrumentation (avec
+//              UNITY_INSTRUMENTATION, durées en cycles du processeur) affiche
+//              en plus le rapport d'InstrumentationUnity et vérifie ses
+//              octets contre le compteur du tas de l'hôte ;
+//              bench_instrumentation_sans donne les mêmes mesures sans
+//              instrumentation, pour en lire le surcoût.
+//              Usage : bench_instrumentation[_sans] [resultats.csv]
+
+#include <Arduino.h>
+#include "banc.h"
+#ifdef UNITY_INSTRUMENTATION
+#define UNITY_HORLOGE() banc::cycles()
+#endif
+#include "Unity.h"
+#include "valeurs_SI.h"
+
+using banc::Jeu;
+
+// Sortie qui jette tout (le coût de l'UART n'est pas mesuré ici)
+class SortieNulle : public Print {
+public:
+    using Print::write;
+    size_t write(uint8_t) override { return 1; }
+    size_t write(const uint8_t*, size_t taille) override { return taille; }
+};
+
+static SortieNulle nulle;
+
+// Un rapport : chaque point d'entrée une ou plusieurs fois
+static size_t rapport(const Jeu& jeu, size_t i) {
+    char tampon[64];
+    float v = jeu.valeurs[i] * 30.0f;
+    size_t n = Tension::afficher(v, 2).length();
+    n += C_UNITY::valeurAvecUnite(v, "V", 2).length();   // Symbole passé en String
+    n += Courant::afficher(tampon, sizeof(tampon), v / 1000.0f);
+    n += Puissance::afficher(nulle, v * 2.0f);
+    n += Tension::afficher(tampon, sizeof(tampon), jeu.valeurs, 8);
+    n += C_UNITY::formatNombre(v * 1.0e5f, 2).length();
+    n += C_UNITY::formatNombre(tampon, sizeof(tampon), v * 1.0e5f, 2);
+    return n;
+}
+
+int main(int argc, char** argv) {
+    static Jeu jeu;
+    banc::remplirPlage(jeu, 1.0f);
+    jeu.nom = "atto..tera";
+
+#ifdef UNITY_INSTRUMENTATION
+    // Rapport d'instrumentation sur 10000 rapports, octets comparés au tas
+    InstrumentationUnity::effacer();
+    hote::CompteurTas avant = hote::compteurTas();
+    for (size_t k = 0; k < 10000; k++) banc::puits += rapport(jeu, k % jeu.n);
+    hote::CompteurTas apres = hote::compteurTas();
+    unsigned long allocations = 0, octets = 0;
+    for (int p = 0; p < InstrumentationUnity::NB_POINTS; p++) {
+        allocations += InstrumentationUnity::lire((InstrumentationUnity::Point)p).allocations;
+        octets += InstrumentationUnity::lire((InstrumentationUnity::Point)p).octets;
+    }
+    printf("10000 rapports, durees en cycles :\n");
+    InstrumentationUnity::rapport(Serial);
+    bool juste = allocations == apres.allocations - avant.allocations && octets == apres.octets - avant.octets;
+    printf("Tas de l'hote : %lu allocations, %lu octets ; instrumentation : %lu, %lu (%s)\n\n",
+           apres.allocations - avant.allocations, apres.octets - avant.octets, allocations, octets,
+           juste ? "identiques" : "DIFFERENTS");
+    banc::demarrer("Points d'entree instrumentes (par appel)", argc, argv);
+#else
+    bool juste = true;
+    banc::demarrer("Points d'entree sans instrumentation (par appel)", argc, argv);
+#endif
+
+    banc::mesurer("afficher -> String", jeu, [](const Jeu& e, size_t i) {
+        return Tension::afficher(e.valeurs[i]).length();
+    });
+    banc::mesurer("afficher(char*)", jeu, [](const Jeu& e, size_t i) {
+        char tampon[32];
+        return Tension::afficher(tampon, sizeof(tampon), e.valeurs[i]);
+    });
+    banc::mesurer("afficher(Print&)", jeu, [](const Jeu& e, size_t i) {
+        return Tension::afficher(nulle, e.valeurs[i]);
+    });
+    banc::mesurer("formatNombre(char*)", jeu, [](const Jeu& e, size_t i) {
+        char tampon[32];
+        return C_UNITY::formatNombre(tampon, sizeof(tampon), e.valeurs[i] * 1.0e5f, 2);
+    });
+    banc::mesurer("rapport complet", jeu, rapport);
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
@@ -0,0 +1,173 @@
+// bench_lecture.cpp - Banc d'essai de la lecture de valeurs formatées
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Lit un corpus de textes produits par valeurAvecUnite ("4.700 kΩ",
+//              "100nF", "2.4GHz") pour toutes les classes du répertoire :
+//              table de hachage (RepertoireSI), lecture typée (Grandeur::lire)
+//              et, en référence, strtod suivi d'une recherche linéaire du
+//              symbole. Vérifie l'aller-retour, et le refus des nombres hors
+//              de la plage du float, avant de mesurer.
+//              Usage : bench_lecture [resultats.csv]
+
+#include <Arduino.h>
+#include <stdlib.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+static const size_t TAILLE_CORPUS = 4096;
+static const size_t TAILLE_TEXTE = 32;
+
+struct Corpus {
+    char textes[TAILLE_CORPUS][TAILLE_TEXTE];
+    float valeurs[TAILLE_CORPUS];
+    float tolerances[TAILLE_CORPUS];  // Écart relatif dû à l'arrondi de l'affichage
+    uint8_t unites[TAILLE_CORPUS];
+};
+
+/**
+ * Symbole vide, ou qui devient un autre symbole déclaré une fois préfixé
+ * ("s" et "ms", "W" et "kW", "T" et "µT") : "6ms" est relu DureeCrete,
+ * l'aller-retour ne peut pas retrouver milli-Temps
+ */
+static bool symboleAmbigu(uint8_t id) {
+    static const char* const prefixes[] = { "q", "r", "y", "z", "a", "f", "p", "n", "µ", "m",
+                                            "k", "M", "G", "T", "P", "E", "Z", "Y", "R", "Q" };
+    const char* s = reinterpret_cast<const char*>(RepertoireSI::symbole(id));
+    if (*s == '\0') return true;
+    for (const char* p : prefixes) {
+        char prefixe[TAILLE_TEXTE];
+        snprintf(prefixe, sizeof(prefixe), "%s%s", p, s);
+        if (RepertoireSI::chercher(prefixe, strlen(prefixe)) != RepertoireSI::AUCUNE) return true;
+    }
+    return false;
+}
+
+/**
+ * Textes formatés avec 0 à 3 décimales, avec ou sans espace avant le
+ * préfixe, pour des identifiants tirés dans tout le répertoire
+ */
+static void remplirCorpus(Corpus& c, const Jeu& jeu) {
+    for (size_t i = 0; i < TAILLE_CORPUS; i++) {
+        uint8_t id;
+        do {
+            id = (uint8_t)(1 + banc::aleatoire() % (RepertoireSI::NB_ENTREES - 1));
+        } while (symboleAmbigu(id));
+        float val = jeu.valeurs[i % jeu.n];
+        bool espace = (banc::aleatoire() & 1) != 0;
+        int decimales = (int)(banc::aleatoire() % 4);
+        C_UNITY::valeurAvecUnite(c.textes[i], TAILLE_TEXTE, val, RepertoireSI::symbole(id), decimales, espace);
+        // Un symbole déclaré plusieurs fois désigne la première classe
+        const char* s = reinterpret_cast<const char*>(RepertoireSI::symbole(id));
+        c.unites[i] = RepertoireSI::chercher(s, strlen(s));
+        c.valeurs[i] = val;
+        c.tolerances[i] = 0.5f * powf(10.0f, (float)-decimales) + 1.0e-6f;
+    }
+}
+
+/**
+ * Référence : ce que l'on écrit à la main sans le répertoire (strtod, puis
+ * symbole comparé à chaque classe, d'abord tel quel puis sans préfixe)
+ */
+static bool lectureLineaire(const char* texte, float& valeur, uint8_t& unite) {
+    char* fin;
+    double v = strtod(texte, &fin);
+    if (fin == texte) return false;
+    while (*fin == ' ') fin++;
+
+    for (int passe = 0; passe < 2; passe++) {
+        int indice = C_UNITY_BASE::INDICE_UNITE;
+        const char* symbole = fin;
+        if (passe == 1) {
+            uint8_t lus = C_UNITY_BASE::lirePrefixe(fin, fin + strlen(fin), indice);
+            if (!lus) return false;
+            symbole += lus;
+        }
+        for (uint8_t id = 1; id < RepertoireSI::NB_ENTREES; id++) {
+            if (strcmp(symbole, reinterpret_cast<const char*>(RepertoireSI::symbole(id))) == 0) {
+                valeur = (float)(v * pow(10.0, 3 * (indice - C_UNITY_BASE::INDICE_UNITE)));
+                unite = id;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// La mantisse affichée vaut au moins 1 : l'arrondi à d décimales
+// l'écarte d'au plus 0.5e-d en relatif
+static bool procheDe(float lu, float attendu, float tolerance) {
+    return fabsf(lu - attendu) <= tolerance * fabsf(attendu);
+}
+
+int main(int argc, char** argv) {
+    static Jeu jeux[4];
+    banc::jeuxStandard(jeux);
+    static Corpus corpus;
+    remplirCorpus(corpus, jeux[0]);
+
+    // Même jeu pour la lecture typée : des résistances seules
+    static char resistances[TAILLE_CORPUS][TAILLE_TEXTE];
+    for (size_t i = 0; i < TAILLE_CORPUS; i++) {
+        Resistance::afficher(resistances[i], TAILLE_TEXTE, jeux[0].valeurs[i % jeux[0].n], (int)(i % 4));
+    }
+
+    // Aller-retour : chaque texte relu donne la classe et la valeur écrites
+    size_t justes = 0;
+    for (size_t i = 0; i < TAILLE_CORPUS; i++) {
+        float v;
+        uint8_t id;
+        if (RepertoireSI::lire(corpus.textes[i], v, id) && id == corpus.unites[i] && procheDe(v, corpus.valeurs[i], corpus.tolerances[i])) justes++;
+        else printf("Echec : \"%s\"\n", corpus.textes[i]);
+    }
+    size_t ambigus = 0;
+    for (uint8_t id = 1; id < RepertoireSI::NB_ENTREES; id++) ambigus += symboleAmbigu(id);
+    printf("Aller-retour : %u / %u textes relus (%u classes au symbole ambigu ecartees)\n",
+           (unsigned)justes, (unsigned)TAILLE_CORPUS, (unsigned)ambigus);
+
+    // Hors de la plage du float : refusé comme par strtod (ERANGE), valeur inchangée
+    static const char* const horsPlage[] = { "1e40", "-1e39 A", "400000000QV", "1e38k" };
+    bool refuses = true;
+    for (const char* t : horsPlage) {
+        float v = 1.0f;
+        uint8_t id;
+        Courant c(2.0f);
+        refuses = refuses && !RepertoireSI::lire(t, v, id) && v == 1.0f && !c.lire(t) && c.getValeur() == 2.0f;
+    }
+    printf("Hors plage : %s\n\n", refuses ? "refuses" : "LUS");
+
+    // Le corpus remplace les valeurs du jeu : seuls nom et n servent à la mesure
+    static Jeu jeu;
+    jeu.nom = "corpus SI";
+    jeu.n = TAILLE_CORPUS;
+
+    banc::demarrer("Lecture de valeurs formatees", argc, argv);
+    banc::mesurer("strtod + recherche lineaire", jeu, [&](const Jeu&, size_t i) {
+        float v;
+        uint8_t id = 0;
+        return (size_t)lectureLineaire(corpus.textes[i], v, id) + id;
+    });
+    banc::mesurer("RepertoireSI::lire", jeu, [&](const Jeu&, size_t i) {
+        float v;
+        uint8_t id = 0;
+        return (size_t)RepertoireSI::lire(corpus.textes[i], v, id) + id;
+    });
+    banc::mesurer("RepertoireSI::lire (double)", jeu, [&](const Jeu&, size_t i) {
+        double v;
+        uint8_t id = 0;
+        const char* t = corpus.textes[i];
+        return (size_t)RepertoireSI::lire(t, t + strlen(t), v, id) + id;
+    });
+    banc::mesurer("RepertoireSI::chercher (symbole seul)", jeu, [&](const Jeu&, size_t i) {
+        const char* s = reinterpret_cast<const char*>(RepertoireSI::symbole(corpus.unites[i]));
+        return (size_t)RepertoireSI::chercher(s, strlen(s));
+    });
+    banc::mesurer("Resistance::lire", jeu, [&](const Jeu&, size_t i) {
+        float v = 0;
+        return (size_t)Resistance::lire(resistances[i], v) + (v > 1.0f);
+    });
+    banc::terminer();
+    return justes != TAILLE_CORPUS || !refuses || banc::puits == 0;
+}
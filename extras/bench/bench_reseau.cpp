@@ -0,0 +1,163 @@
+// bench_reseau.cpp - Banc d'essai de l'analyseur de réseau (IEEE 1459)
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Tension et courant secteur synthétiques (harmoniques 3 et 5,
+//              déphasage de 30°), 64 échantillons par période, fenêtres de
+//              10 périodes. Vérifie AnalyseurReseau (CAN 12 bits entier et
+//              float) contre les valeurs analytiques, puis compare son débit
+//              à un calcul en plusieurs passages écrit à la main (moyennes,
+//              puis efficaces et puissance, puis fondamental).
+//              Usage : bench_reseau [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+static const uint16_t P = 64;
+static const uint16_t PERIODES = 10;
+static const size_t FENETRE = (size_t)P * PERIODES;
+
+// CAN 12 bits centré sur 2048 : 325 V et 14.2 A crête ≈ 1800 pas
+static const float GAIN_U = 325.0f / 1800.0f * 1.05f;
+static const float GAIN_I = 14.2f / 1800.0f * 1.3f;
+
+static int16_t brut[2 * FENETRE];
+static float reels[2 * FENETRE];
+
+static void remplir() {
+    for (size_t k = 0; k < FENETRE; k++) {
+        double t = 2.0 * C_UNITY::PI_ * (double)k / P;
+        double u = 230.0 * sqrt(2.0) * (sin(t) + 0.05 * sin(3 * t + 0.3));
+        double i = 10.0 * sqrt(2.0) * (sin(t - C_UNITY::PI_ / 6) + 0.2 * sin(5 * t + 1.0));
+        reels[2 * k] = (float)u;
+        reels[2 * k + 1] = (float)i;
+        brut[2 * k] = (int16_t)lround(2048.0 + u / GAIN_U);
+        brut[2 * k + 1] = (int16_t)lround(2048.0 + i / GAIN_I);
+    }
+}
+
+/**
+ * Ce que chaque compteur réimplémente : une passe par étape sur la fenêtre
+ * mémorisée, fondamental par sin/cos à chaque échantillon (ou par table)
+ */
+static MesuresReseau plusieursPassages(const float* ech, size_t n, bool table) {
+    static float cosinus[P], sinus[P];
+    if (table && cosinus[0] == 0) {
+        for (uint16_t k = 0; k < P; k++) {
+            cosinus[k] = cosf(2.0f * (float)C_UNITY::PI_ * k / P);
+            sinus[k] = sinf(2.0f * (float)C_UNITY::PI_ * k / P);
+        }
+    }
+    double mu = 0, mi = 0;
+    for (size_t k = 0; k < n; k++) mu += ech[2 * k];
+    for (size_t k = 0; k < n; k++) mi += ech[2 * k + 1];
+    mu /= n;
+    mi /= n;
+    double u2 = 0, i2 = 0, p = 0;
+    for (size_t k = 0; k < n; k++) u2 += (ech[2 * k] - mu) * (ech[2 * k] - mu);
+    for (size_t k = 0; k < n; k++) i2 += (ech[2 * k + 1] - mi) * (ech[2 * k + 1] - mi);
+    for (size_t k = 0; k < n; k++) p += (ech[2 * k] - mu) * (ech[2 * k + 1] - mi);
+    double uc = 0, us = 0, ic = 0, is = 0;
+    for (size_t k = 0; k < n; k++) {
+        float c, s;
+        if (table) {
+            c = cosinus[k % P];
+            s = sinus[k % P];
+        } else {
+            c = cosf(2.0f * (float)C_UNITY::PI_ * (float)(k % P) / P);
+            s = sinf(2.0f * (float)C_UNITY::PI_ * (float)(k % P) / P);
+        }
+        uc += ech[2 * k] * c;
+        us += ech[2 * k] * s;
+        ic += ech[2 * k + 1] * c;
+        is += ech[2 * k + 1] * s;
+    }
+    double u = sqrt(u2 / n), i = sqrt(i2 / n);
+    double k2 = 2.0 / ((double)n * n);
+    double u1 = sqrt((uc * uc + us * us) * k2), i1 = sqrt((ic * ic + is * is) * k2);
+    double p1 = (uc * ic + us * is) * k2, q1 = (uc * is - us * ic) * k2;
+    MesuresReseau m;
+    m.tension = (float)u;
+    m.courant = (float)i;
+    m.active = (float)(p / n);
+    m.apparente = (float)(u * i);
+    m.reactive = (float)q1;
+    double d = u * i * u * i - p / n * p / n - q1 * q1;
+    m.deformante = (float)sqrt(d > 0 ? d : 0);
+    m.cosPhi = (float)(p1 / (u1 * i1));
+    m.lambda = (float)(p / n / (u * i));
+    m.thdTension = (float)(100.0 * sqrt(u * u / (u1 * u1) - 1.0));
+    m.thdCourant = (float)(100.0 * sqrt(i * i / (i1 * i1) - 1.0));
+    return m;
+}
+
+static bool proche(float lu, double attendu, double tolerance) {
+    return fabs(lu - attendu) <= tolerance * fabs(attendu);
+}
+
+static bool verifier(const char* nom, const MesuresReseau& m, double tolerance) {
+    const double u = 230.0 * sqrt(1.0025), i = 10.0 * sqrt(1.04);
+    const double p = 2300.0 * cos(C_UNITY::PI_ / 6), q = 1150.0, s = u * i;
+    bool juste = proche(m.tension.getValeur(), u, tolerance) && proche(m.courant.getValeur(), i, tolerance)
+              && proche(m.active.getValeur(), p, tolerance) && proche(m.apparente.getValeur(), s, tolerance)
+              && proche(m.reactive.getValeur(), q, tolerance) && proche(m.deformante.getValeur(), sqrt(s * s - 2300.0 * 2300.0), 10 * tolerance)
+              && proche(m.cosPhi.getValeur(), cos(C_UNITY::PI_ / 6), tolerance) && proche(m.lambda.getValeur(), p / s, tolerance)
+              && proche(m.thdTension.getValeur(), 5.0, 10 * tolerance) && proche(m.thdCourant.getValeur(), 20.0, tolerance);
+    Serial.print(nom);
+    Serial.print(" : ");
+    m.tension.afficher(Serial, 3);
+    m.courant.afficher(Serial, 3);
+    m.active.afficher(Serial, 3);
+    m.reactive.afficher(Serial, 3);
+    m.apparente.afficher(Serial, 3);
+    Serial.print(" cos phi ");
+    Serial.print(m.cosPhi.getValeur(), 4);
+    Serial.print(" THD ");
+    Serial.print(m.thdTension.getValeur(), 2);
+    Serial.print("/");
+    Serial.print(m.thdCourant.getValeur(), 2);
+    Serial.println(juste ? " %  juste" : " %  FAUX");
+    return juste;
+}
+
+int main(int argc, char** argv) {
+    remplir();
+    static AnalyseurReseau<P> entier(GAIN_U, GAIN_I, PERIODES);
+    static AnalyseurReseau<P, float> reel(1.0f, 1.0f, PERIODES);
+
+    // Blocs de 48 paires : les fenêtres ne tombent pas en fin de bloc
+    for (size_t k = 0; k < FENETRE; k += 48) entier.ajouter(brut + 2 * k, FENETRE - k < 48 ? FENETRE - k : 48);
+    reel.ajouter(reels, FENETRE);
+    bool juste = verifier("CAN 12 bits (int16)", entier.mesures(), 5e-4);  // Bruit de quantification
+    juste = verifier("float              ", reel.mesures(), 1e-5) && juste;
+    juste = verifier("plusieurs passages ", plusieursPassages(reels, FENETRE, true), 1e-5) && juste;
+    printf("Etat de l'analyseur : %u octets (int16), %u octets (float)\n\n",
+           (unsigned)sizeof(AnalyseurReseau<P>), (unsigned)sizeof(AnalyseurReseau<P, float>));
+
+    // Débit : une fenêtre de 640 paires par appel, en blocs de 64
+    static Jeu jeu;
+    jeu.nom = "10 periodes";
+    jeu.n = FENETRE;
+    banc::demarrer("Analyse de reseau (par paire u, i)", argc, argv);
+    banc::mesurer("plusieurs passages, sin/cos", jeu, [&](const Jeu&, size_t) {
+        return (size_t)(plusieursPassages(reels, FENETRE, false).active.getValeur() > 0);
+    }, FENETRE);
+    banc::mesurer("plusieurs passages, table", jeu, [&](const Jeu&, size_t) {
+        return (size_t)(plusieursPassages(reels, FENETRE, true).active.getValeur() > 0);
+    }, FENETRE);
+    banc::mesurer("AnalyseurReseau<64, float>", jeu, [&](const Jeu&, size_t) {
+        size_t n = 0;
+        for (size_t k = 0; k < FENETRE; k += P) n += reel.ajouter(reels + 2 * k, P);
+        return n;
+    }, FENETRE);
+    banc::mesurer("AnalyseurReseau<64> (CAN int16)", jeu, [&](const Jeu&, size_t) {
+        size_t n = 0;
+        for (size_t k = 0; k < FENETRE; k += P) n += entier.ajouter(brut + 2 * k, P);
+        return n;
+    }, FENETRE);
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
@@ -0,0 +1,194 @@
+// bench_serie.cpp - Banc d'essai des séries temporelles
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Historique de 65536 tensions (18 h à une mesure par seconde,
+//              déjà tourné plusieurs fois) : résumés de plages quelconques
+//              comparés à un parcours complet, courbes min/max et LTTB de
+//              240 points vérifiées, mesures nan ignorées ; puis coût d'un
+//              ajout et d'un tracé de toute la fenêtre ou de sa dernière
+//              heure, contre le parcours de tous les échantillons à chaque
+//              tracé.
+//              Usage : bench_serie [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+static const size_t N = 65536;
+static const size_t POINTS = 240;
+typedef SerieTemporelle<Tension, N> Historique;
+typedef Historique::Point Point;
+
+static Historique historique;
+static Point points[POINTS];
+
+static float tension(uint32_t t) {
+    // Secteur qui dérive lentement, bruit, une chute brève toutes les ~3 h
+    // et une lecture en défaut (nan, ignorée par l'historique) toutes les ~1 h 20
+    float u = 230.0f + 4.0f * sinf((float)t * 1e-4f) + (float)(banc::aleatoire() % 201) / 100.0f - 1.0f;
+    if (t % 4999 == 2500) return NAN;
+    return t % 10007 == 5000 ? 184.0f : u;
+}
+
+/**
+ * Ce que l'on écrit sans pyramide : chaque tracé relit tous les
+ * échantillons, minimum et maximum par tranche
+ */
+static size_t minMaxParcours(uint32_t debut, uint32_t fin, Point* sortie, size_t nbPoints) {
+    uint32_t largeur = (uint32_t)((fin - debut + nbPoints / 2 - 1) / (nbPoints / 2));
+    size_t n = 0;
+    for (uint32_t a = debut; a < fin; a += largeur) {
+        uint32_t b = a + largeur < fin ? a + largeur : fin;
+        float bas = historique[a].getValeur(), haut = bas;
+        for (uint32_t r = a + 1; r < b; r++) {
+            float v = historique[r].getValeur();
+            if (v < bas) bas = v;
+            if (haut < v) haut = v;
+        }
+        sortie[n++] = { a, bas };
+        sortie[n++] = { b - 1, haut };
+    }
+    return n;
+}
+
+// LTTB d'origine (Steinarsson), sur tous les échantillons
+static size_t lttbParcours(uint32_t debut, uint32_t fin, Point* sortie, size_t nbPoints) {
+    double largeur = (double)(fin - debut - 2) / (double)(nbPoints - 2);
+    size_t n = 0;
+    uint32_t retenu = debut;
+    sortie[n++] = { debut, historique[debut].getValeur() };
+    for (size_t k = 0; k < nbPoints - 2; k++) {
+        uint32_t a = debut + 1 + (uint32_t)(k * largeur), b = debut + 1 + (uint32_t)((k + 1) * largeur);
+        uint32_t c = debut + 1 + (uint32_t)((k + 2) * largeur);
+        if (c > fin) c = fin;
+        double xm = 0, ym = 0;
+        for (uint32_t r = b; r < c; r++) {
+            xm += r;
+            ym += historique[r].getValeur();
+        }
+        xm /= (double)(c - b);
+        ym /= (double)(c - b);
+        double ya = historique[retenu].getValeur(), meilleure = -1;
+        for (uint32_t r = a; r < b; r++) {
+            double aire = fabs(((double)r - retenu) * (ym - ya) - (xm - retenu) * (historique[r].getValeur() - ya));
+            if (aire > meilleure) {
+                meilleure = aire;
+                retenu = r;
+            }
+        }
+        sortie[n++] = { retenu, historique[retenu].getValeur() };
+    }
+    sortie[n++] = { fin - 1, historique[fin - 1].getValeur() };
+    return n;
+}
+
+static bool verifierResume(uint32_t debut, uint32_t fin) {
+    Historique::Resume r = historique.resumer(debut, fin);
+    float bas = historique[debut].getValeur(), haut = bas;
+    double somme = 0;
+    for (uint32_t k = debut; k < fin; k++) {
+        float v = historique[k].getValeur();
+        if (v < bas) bas = v;
+        if (haut < v) haut = v;
+        somme += v;
+    }
+    double moyenne = somme / (fin - debut);
+    return r.nombre == fin - debut && r.minimum.getValeur() == bas && r.maximum.getValeur() == haut
+        && fabs(r.moyenne.getValeur() - moyenne) <= 1e-5 * moyenne;
+}
+
+// Courbe min/max : au plus nbPoints, rangs croissants, crêtes de la plage présentes
+static bool verifierMinMax(uint32_t debut, uint32_t fin) {
+    size_t n = historique.decimerMinMax(debut, fin, points, POINTS);
+    Historique::Resume r = historique.resumer(debut, fin);
+    bool bas = false, haut = false, ordre = n > 0 && n <= POINTS;
+    for (size_t k = 0; k < n; k++) {
+        bas = bas || points[k].valeur == r.minimum.getValeur();
+        haut = haut || points[k].valeur == r.maximum.getValeur();
+        ordre = ordre && (k == 0 || points[k - 1].rang <= points[k].rang) && points[k].rang >= debut && points[k].rang < fin;
+    }
+    return ordre && bas && haut;
+}
+
+static bool verifierLTTB(uint32_t debut, uint32_t fin) {
+    size_t n = historique.decimerLTTB(debut, fin, points, POINTS);
+    bool juste = n == (fin - debut < POINTS ? fin - debut : POINTS) && points[0].rang == debut && points[n - 1].rang == fin - 1;
+    for (size_t k = 1; k < n; k++) juste = juste && points[k - 1].rang < points[k].rang;
+    return juste;
+}
+
+int main(int argc, char** argv) {
+    // Trois tours de l'anneau : les résumés doivent suivre les blocs écrasés
+    uint32_t t = 0, invalides = 0;
+    for (; t < 3 * N + 1234; t++) {
+        float v = tension(t);
+        invalides += isnan(v);
+        historique.ajouter(v);
+    }
+    uint32_t premier = historique.premier(), fin = historique.fin();
+    printf("Historique : %u tensions conservees (rangs %u a %u, %u nan ignores), %u octets (valeurs seules : %u)\n",
+           (unsigned)historique.taille(), (unsigned)premier, (unsigned)fin - 1, (unsigned)invalides,
+           (unsigned)sizeof(historique), (unsigned)(N * sizeof(float)));
+
+    bool juste = invalides > 0 && fin == t - invalides;  // Une mesure nan ne prend pas de rang
+    juste = juste && verifierResume(premier, fin) && verifierMinMax(premier, fin) && verifierLTTB(premier, fin);
+    for (int k = 0; k < 200; k++) {
+        uint32_t a = premier + banc::aleatoire() % N;
+        uint32_t b = a + 1 + banc::aleatoire() % (fin - a);
+        juste = juste && verifierResume(a, b) && verifierMinMax(a, b) && (b - a < 3 || verifierLTTB(a, b));
+    }
+    printf("Resumes, courbes min/max et LTTB sur 200 plages : %s\n", juste ? "justes" : "FAUX");
+
+    Historique::Resume r = historique.resumer(premier, fin);
+    printf("Minimum ");
+    r.minimum.afficher(Serial);
+    printf(", maximum ");
+    r.maximum.afficher(Serial);
+    printf(", moyenne ");
+    r.moyenne.afficher(Serial);
+    size_t n = historique.decimerLTTB(premier, fin, points, POINTS);
+    printf("\nCourbe LTTB de %u points ; derniere heure : moyenne ", (unsigned)n);
+    historique.resumer(fin - 3600, fin).moyenne.afficher(Serial);
+    printf("\n\n");
+
+    static Jeu ajout, trace;
+    ajout.nom = "par mesure";
+    ajout.n = banc::TAILLE_JEU;
+    for (size_t i = 0; i < banc::TAILLE_JEU; i++) ajout.valeurs[i] = tension(t + (uint32_t)i);
+    trace.nom = "240 points";
+    trace.n = 1;
+
+    banc::demarrer("Series temporelles", argc, argv);
+    banc::mesurer("SerieTemporelle::ajouter", ajout, [&](const Jeu& e, size_t i) {
+        historique.ajouter(e.valeurs[i]);
+        return (size_t)1;
+    });
+    premier = historique.premier();
+    fin = historique.fin();
+    banc::mesurer("parcours : min/max 18 h", trace, [&](const Jeu&, size_t) {
+        return minMaxParcours(premier, fin, points, POINTS);
+    });
+    banc::mesurer("decimerMinMax 18 h", trace, [&](const Jeu&, size_t) {
+        return historique.decimerMinMax(premier, fin, points, POINTS);
+    });
+    banc::mesurer("parcours : LTTB 18 h", trace, [&](const Jeu&, size_t) {
+        return lttbParcours(premier, fin, points, POINTS);
+    });
+    banc::mesurer("decimerLTTB 18 h", trace, [&](const Jeu&, size_t) {
+        return historique.decimerLTTB(premier, fin, points, POINTS);
+    });
+    banc::mesurer("parcours : min/max 1 h", trace, [&](const Jeu&, size_t) {
+        return minMaxParcours(fin - 3600, fin, points, POINTS);
+    });
+    banc::mesurer("decimerMinMax 1 h", trace, [&](const Jeu&, size_t) {
+        return historique.decimerMinMax(fin - 3600, fin, points, POINTS);
+    });
+    banc::mesurer("resumer 18 h", trace, [&](const Jeu&, size_t) {
+        return (size_t)historique.resumer(premier, fin).nombre;
+    });
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
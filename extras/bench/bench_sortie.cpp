@@ -0,0 +1,178 @@
+// bench_sortie.cpp - Banc d'essai de l'écriture dans une sortie Print
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Rejoue le rapport périodique de loop() (Exemple_Valeurs_SI) :
+//              quatre libellés et quatre mesures envoyés à une UART simulée,
+//              par String (Serial.println(Tension::afficher(v))), par
+//              afficher(Print&) et par une SortieGroupee<64>. Mesure le temps
+//              et les allocations par rapport, le nombre d'appels à write()
+//              et la pile consommée (pile peinte puis relue, comme sur AVR).
+//              Usage : bench_sortie [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+/**
+ * UART simulée : copie dans un anneau de 64 octets (le tampon d'émission de
+ * HardwareSerial) et compte les appels, dont chacun coûte sur la carte
+ * (section critique, paquet USB CDC...)
+ */
+class SortieUart : public Print {
+public:
+    unsigned long appels = 0;
+    unsigned long octets = 0;
+
+    using Print::write;
+
+    size_t write(uint8_t c) override {
+        appels++;
+        anneau[octets++ & 63] = c;
+        return 1;
+    }
+
+    size_t write(const uint8_t* donnees, size_t taille) override {
+        appels++;
+        for (size_t i = 0; i < taille; i++) anneau[octets++ & 63] = donnees[i];
+        return taille;
+    }
+
+private:
+    uint8_t anneau[64];
+};
+
+static SortieUart uart;
+
+struct Mesures {
+    float tension, courant, resistance, puissance;
+};
+
+static Mesures mesures(const Jeu& jeu, size_t i) {
+    Mesures m;
+    m.tension = fabsf(jeu.valeurs[i]);
+    m.courant = fabsf(jeu.valeurs[(i + 1) % jeu.n]);
+    m.resistance = fabsf(jeu.valeurs[(i + 2) % jeu.n]);
+    m.puissance = m.tension * m.courant;
+    return m;
+}
+
+// Le rapport de loop() avant cette version : une String par mesure
+__attribute__((noinline)) static size_t rapportString(Print& sortie, const Mesures& m) {
+    size_t n = sortie.println("\n--- MESURES PÉRIODIQUES ---");
+    n += sortie.print("Tension: ");
+    n += sortie.println(Tension::afficher(m.tension, 2));
+    n += sortie.print("Courant: ");
+    n += sortie.println(Courant::afficher(m.courant, 6));
+    n += sortie.print("Résistance: ");
+    n += sortie.println(Resistance::afficher(m.resistance, 0));
+    n += sortie.print("Puissance: ");
+    n += sortie.println(Puissance::afficher(m.puissance, 3));
+    return n;
+}
+
+// Même rapport, chaque mesure écrite directement dans la sortie
+__attribute__((noinline)) static size_t rapportPrint(Print& sortie, const Mesures& m) {
+    size_t n = sortie.println("\n--- MESURES PÉRIODIQUES ---");
+    n += sortie.print("Tension: ");
+    n += Tension::afficher(sortie, m.tension, 2);
+    n += sortie.println();
+    n += sortie.print("Courant: ");
+    n += Courant::afficher(sortie, m.courant, 6);
+    n += sortie.println();
+    n += sortie.print("Résistance: ");
+    n += Resistance::afficher(sortie, m.resistance, 0);
+    n += sortie.println();
+    n += sortie.print("Puissance: ");
+    n += Puissance::afficher(sortie, m.puissance, 3);
+    n += sortie.println();
+    return n;
+}
+
+// Idem à travers un tampon d'écriture groupée de 64 octets
+__attribute__((noinline)) static size_t rapportGroupe(Print& sortie, const Mesures& m) {
+    C_UNITY::SortieGroupee<64> rapport(sortie);
+    return rapportPrint(rapport, m);
+}
+
+// ============================================================================
+// PILE CONSOMMÉE (PEINTURE)
+// ============================================================================
+
+static const size_t ZONE_PILE = 4096;
+static const uint8_t MOTIF = 0xA5;
+
+// La zone de ces deux fonctions recouvre celle qu'utilise le rapport appelé
+// entre elles depuis le même cadre
+__attribute__((noinline)) static uint8_t peindrePile() {
+    volatile uint8_t zone[ZONE_PILE];
+    for (size_t i = 0; i < ZONE_PILE; i++) zone[i] = MOTIF;
+    return zone[0];
+}
+
+__attribute__((noinline)) static size_t pileTouchee() {
+    volatile uint8_t zone[ZONE_PILE];
+    zone[ZONE_PILE - 1] = MOTIF;  // Seul octet écrit : le reste est relu tel que laissé
+    size_t libres = 0;
+    while (libres < ZONE_PILE && zone[libres] == MOTIF) libres++;
+    return ZONE_PILE - libres;
+}
+
+template <class Rapport>
+static size_t pileRapport(Rapport rapport, const Mesures& m) {
+    banc::puits += peindrePile();
+    rapport(uart, m);
+    return pileTouchee();
+}
+
+__attribute__((noinline)) static size_t rapportVide(Print&, const Mesures&) { return 0; }
+
+int main(int argc, char** argv) {
+    static Jeu jeux[4];
+    banc::jeuxStandard(jeux);
+    const Jeu& jeu = jeux[0];
+
+    // Même texte par les trois chemins
+    static char textes[3][512];
+    Mesures m = mesures(jeu, 0);
+    size_t (*rapports[3])(Print&, const Mesures&) = { rapportString, rapportPrint, rapportGroupe };
+    for (int r = 0; r < 3; r++) {
+        class Copie : public Print {
+        public:
+            char* out;
+            size_t len = 0;
+            explicit Copie(char* o) : out(o) {}
+            using Print::write;
+            size_t write(uint8_t c) override { out[len++] = (char)c; out[len] = '\0'; return 1; }
+        } copie(textes[r]);
+        rapports[r](copie, m);
+    }
+    bool identiques = strcmp(textes[0], textes[1]) == 0 && strcmp(textes[0], textes[2]) == 0;
+    printf("Rapports identiques : %s\n%s\n", identiques ? "oui" : "NON", textes[0]);
+
+    banc::demarrer("Rapport periodique vers une sortie Print (4 mesures)", argc, argv);
+    banc::mesurer("println(Grandeur::afficher(v)) String", jeu, [&](const Jeu& e, size_t i) {
+        return rapportString(uart, mesures(e, i));
+    });
+    banc::mesurer("Grandeur::afficher(Print&, v)", jeu, [&](const Jeu& e, size_t i) {
+        return rapportPrint(uart, mesures(e, i));
+    });
+    banc::mesurer("afficher(SortieGroupee<64>&, v)", jeu, [&](const Jeu& e, size_t i) {
+        return rapportGroupe(uart, mesures(e, i));
+    });
+    banc::terminer();
+
+    // Appels à write() et pile, par rapport
+    const size_t base = pileRapport(rapportVide, m);
+    const char* noms[3] = { "String", "Print&", "SortieGroupee<64>" };
+    printf("\n%-20s %14s %14s\n", "chemin", "write()/rapport", "pile (octets)");
+    for (int r = 0; r < 3; r++) {
+        uart.appels = 0;
+        for (size_t i = 0; i < jeu.n; i++) rapports[r](uart, mesures(jeu, i));
+        size_t pile = pileRapport(rapports[r], m);
+        printf("%-20s %14.1f %14u\n", noms[r], (double)uart.appels / (double)jeu.n, (unsigned)(pile - base));
+    }
+    return !identiques || banc::puits == 0;
+}
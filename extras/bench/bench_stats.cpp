@@ -0,0 +1,160 @@
+// bench_stats.cpp - Banc d'essai des statistiques en continu
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Tension secteur échantillonnée (230 V, ondulation et bruit)
+//              sur dix millions de points : moyenne, écart-type et RMS par
+//              sommes simples en float (le code écrit à la main) et par
+//              Stats<Tension> en float (comme sur AVR, double = float) et en
+//              double, comparés à une référence en long double. Vérifie la
+//              fusion d'accumulateurs partiels puis mesure le coût par
+//              échantillon.
+//              Usage : bench_stats [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+static const uint32_t NB_ECHANTILLONS = 10000000;
+static const int NB_PRODUCTEURS = 4;
+
+/**
+ * Échantillon i : 230 V, ondulation de 0.5 V à 100 Hz (échantillonnage
+ * 10 kHz) et bruit uniforme de ±50 mV, arrondi au float comme un relevé
+ */
+static float echantillon(uint32_t i) {
+    static uint32_t etat;
+    if (i == 0) etat = 2463534242u;
+    etat ^= etat << 13;
+    etat ^= etat >> 17;
+    etat ^= etat << 5;
+    double bruit = ((double)(etat % 100001) / 100000.0 - 0.5) * 0.1;
+    return (float)(230.0 + 0.5 * sin(2.0 * C_UNITY::PI_ * (double)(i % 100) / 100.0) + bruit);
+}
+
+/**
+ * Ce que l'on écrit à la main : somme et somme des carrés en float
+ */
+struct SommesFloat {
+    uint32_t n = 0;
+    float somme = 0, carres = 0, mini = 0, maxi = 0;
+
+    void ajouter(float x) {
+        if (n == 0 || x < mini) mini = x;
+        if (n == 0 || x > maxi) maxi = x;
+        n++;
+        somme += x;
+        carres += x * x;
+    }
+
+    float moyenne() const { return somme / (float)n; }
+    float ecartType() const {
+        float m = moyenne();
+        float v = carres / (float)n - m * m;
+        return v > 0 ? sqrtf(v) : 0.0f;
+    }
+    float rms() const { return sqrtf(carres / (float)n); }
+};
+
+struct Resultat {
+    const char* nom;
+    double moyenne, ecartType, rms;
+};
+
+static void afficherLigne(const Resultat& r, const Resultat& ref) {
+    printf("%-26s %12.6f %10.3e %12.6f %10.3e %12.6f %10.3e\n", r.nom,
+           r.moyenne, fabs(r.moyenne - ref.moyenne) / ref.moyenne,
+           r.ecartType, fabs(r.ecartType - ref.ecartType) / ref.ecartType,
+           r.rms, fabs(r.rms - ref.rms) / ref.rms);
+}
+
+template <class S>
+static Resultat resultat(const char* nom, const S& s) {
+    Resultat r = { nom, (double)s.moyenne().getValeur(), (double)s.ecartType().getValeur(), (double)s.rms().getValeur() };
+    return r;
+}
+
+int main(int argc, char** argv) {
+    // Référence : deux passes en long double
+    long double somme = 0;
+    for (uint32_t i = 0; i < NB_ECHANTILLONS; i++) somme += echantillon(i);
+    long double moyenne = somme / NB_ECHANTILLONS, ecarts = 0;
+    for (uint32_t i = 0; i < NB_ECHANTILLONS; i++) {
+        long double e = echantillon(i) - moyenne;
+        ecarts += e * e;
+    }
+    Resultat ref = { "reference (long double)", (double)moyenne, (double)sqrtl(ecarts / NB_ECHANTILLONS),
+                     (double)sqrtl(moyenne * moyenne + ecarts / NB_ECHANTILLONS) };
+
+    SommesFloat simple;
+    Stats<Tension, float> statsFloat;
+    Stats<Tension> statsDouble;
+    Stats<Tension, float> partiels[NB_PRODUCTEURS];
+    for (uint32_t i = 0; i < NB_ECHANTILLONS; i++) {
+        float x = echantillon(i);
+        simple.ajouter(x);
+        statsFloat.ajouter(x);
+        statsDouble.ajouter(x);
+        partiels[i % NB_PRODUCTEURS].ajouter(x);  // Échantillons répartis entre producteurs
+    }
+    Stats<Tension, float> fusion;
+    for (int p = 0; p < NB_PRODUCTEURS; p++) fusion += partiels[p];
+
+    printf("%u echantillons, 230 V +- 0.5 V (ecarts relatifs a la reference)\n", (unsigned)NB_ECHANTILLONS);
+    printf("%-26s %12s %10s %12s %10s %12s %10s\n", "calcul", "moyenne", "ecart", "ecart-type", "ecart", "rms", "ecart");
+    afficherLigne(ref, ref);
+    Resultat r = { "sommes simples (float)", simple.moyenne(), simple.ecartType(), simple.rms() };
+    afficherLigne(r, ref);
+    afficherLigne(resultat("Stats<Tension, float>", statsFloat), ref);
+    afficherLigne(resultat("Stats<Tension> (double)", statsDouble), ref);
+    afficherLigne(resultat("4 x float + fusionner", fusion), ref);
+
+    // Float : la moyenne et l'écart-type restent justes à ~1e-6 près
+    bool juste = fusion.nombre() == NB_ECHANTILLONS;
+    const Stats<Tension, float>* verifies[2] = { &statsFloat, &fusion };
+    for (const Stats<Tension, float>* s : verifies) {
+        juste = juste && fabs(s->moyenne().getValeur() - ref.moyenne) < 1e-5 * ref.moyenne
+                      && fabs(s->ecartType().getValeur() - ref.ecartType) < 1e-3 * ref.ecartType
+                      && s->minimum().getValeur() == simple.mini && s->maximum().getValeur() == simple.maxi;
+    }
+    printf("Stats en float et fusion justes : %s\n\n", juste ? "oui" : "NON");
+
+    // Coût par échantillon, sur des tampons de 256 relevés
+    static Jeu jeu;
+    jeu.nom = "secteur";
+    jeu.n = banc::TAILLE_JEU;
+    for (size_t i = 0; i < jeu.n; i++) jeu.valeurs[i] = echantillon((uint32_t)i);
+    static GrandeurEn<Tension, VirguleFixe<16> >::Scalaire fixes[banc::TAILLE_JEU];
+    for (size_t i = 0; i < jeu.n; i++) fixes[i] = jeu.valeurs[i];
+
+    banc::demarrer("Statistiques en continu (par echantillon)", argc, argv);
+    banc::mesurer("sommes simples (float)", jeu, [&](const Jeu& e, size_t) {
+        SommesFloat s;
+        for (size_t i = 0; i < e.n; i++) s.ajouter(e.valeurs[i]);
+        return (size_t)(s.rms() > 0);
+    }, jeu.n);
+    banc::mesurer("Stats<Tension, float>::ajouter", jeu, [&](const Jeu& e, size_t) {
+        Stats<Tension, float> s;
+        s.ajouter(e.valeurs, e.n);
+        return (size_t)(s.rms().getValeur() > 0);
+    }, jeu.n);
+    banc::mesurer("Stats<Tension>::ajouter (double)", jeu, [&](const Jeu& e, size_t) {
+        Stats<Tension> s;
+        s.ajouter(e.valeurs, e.n);
+        return (size_t)(s.rms().getValeur() > 0);
+    }, jeu.n);
+    banc::mesurer("Stats<Tension en VirguleFixe<16>>", jeu, [&](const Jeu& e, size_t) {
+        Stats<GrandeurEn<Tension, VirguleFixe<16> > > s;
+        s.ajouter(fixes, e.n);
+        return (size_t)(s.rms().getValeur() > 0);
+    }, jeu.n);
+    banc::mesurer("fusionner (4 accumulateurs)", jeu, [&](const Jeu&, size_t) {
+        Stats<Tension, float> s;
+        for (int p = 0; p < NB_PRODUCTEURS; p++) s += partiels[p];
+        return (size_t)s.nombre();
+    }, NB_PRODUCTEURS);
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
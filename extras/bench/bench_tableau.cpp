@@ -0,0 +1,156 @@
+// bench_tableau.cpp - Banc d'essai des tableaux de grandeurs
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: 256 relevés de tension et de courant : étalonnage (v * k + d),
+//              somme de deux tableaux, puissance u * i, somme, minimum,
+//              maximum et moyenne, puis affichage de tout le tableau.
+//              Chaque opération est écrite une fois par une boucle sur un
+//              tableau d'objets Tension / Courant (le code habituel) et une
+//              fois par TableauGrandeurs ; résultats comparés, puis coût par
+//              élément.
+//              Usage : bench_tableau [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+static const size_t N = banc::TAILLE_JEU;
+static const float GAIN = 1.0125f;
+static const Tension DECALAGE(-0.012f);
+
+// Boucles sur des objets : ce que l'on écrit sans TableauGrandeurs
+static Tension objetsU[N], objetsV[N];
+static Courant objetsI[N];
+static Puissance objetsP[N];
+
+static TableauGrandeurs<Tension, N> tabU, tabV;
+static TableauGrandeurs<Courant, N> tabI;
+static char texte[N * 16];
+
+static void etalonnerObjets() {
+    for (size_t k = 0; k < N; k++) objetsU[k] = objetsU[k] * GAIN + DECALAGE;
+}
+
+static Tension sommeObjets() {
+    Tension s;
+    for (size_t k = 0; k < N; k++) s += objetsU[k];
+    return s;
+}
+
+static Tension minimumObjets() {
+    Tension m = objetsU[0];
+    for (size_t k = 1; k < N; k++)
+        if (objetsU[k] < m) m = objetsU[k];
+    return m;
+}
+
+static Tension maximumObjets() {
+    Tension m = objetsU[0];
+    for (size_t k = 1; k < N; k++)
+        if (m < objetsU[k]) m = objetsU[k];
+    return m;
+}
+
+static size_t afficherObjets(char* out, size_t cap) {
+    size_t n = 0;
+    for (size_t k = 0; k < N && n + 1 < cap; k++) {
+        if (k) out[n++] = ';';
+        n += objetsU[k].afficher(out + n, cap - n, 3);
+    }
+    return n;
+}
+
+static bool proche(float a, float b) { return fabsf(a - b) <= 1e-5f * fabsf(b); }
+
+int main(int argc, char** argv) {
+    for (size_t k = 0; k < N; k++) {
+        float u = 230.0f + (float)(banc::aleatoire() % 2001) / 100.0f - 10.0f;
+        float i = (float)(banc::aleatoire() % 16000) / 1000.0f;
+        objetsU[k] = u;
+        objetsV[k] = u * 0.01f;
+        objetsI[k] = i;
+        tabU.ajouter(u);
+        tabV.ajouter(u * 0.01f);
+        tabI.ajouter(i);
+    }
+
+    // Mêmes résultats, élément par élément (mêmes opérateurs)
+    etalonnerObjets();
+    tabU.affine(GAIN, DECALAGE);
+    for (size_t k = 0; k < N; k++) objetsP[k] = objetsU[k] * objetsI[k];
+    TableauGrandeurs<Puissance, N> tabP = tabU * tabI;
+    bool juste = tabP.taille() == N;
+    for (size_t k = 0; k < N; k++) {
+        juste = juste && tabU[k].getValeur() == objetsU[k].getValeur()
+                      && tabP[k].getValeur() == objetsP[k].getValeur();
+    }
+    juste = juste && proche(tabU.somme().getValeur(), sommeObjets().getValeur())
+                  && tabU.minimum().getValeur() == minimumObjets().getValeur()
+                  && tabU.maximum().getValeur() == maximumObjets().getValeur();
+    size_t n = tabU.afficher(texte, sizeof(texte));
+    static char texteObjets[sizeof(texte)];
+    juste = juste && n == afficherObjets(texteObjets, sizeof(texteObjets)) && memcmp(texte, texteObjets, n) == 0;
+    printf("Objets et TableauGrandeurs identiques : %s\n", juste ? "oui" : "NON");
+    printf("Moyenne ");
+    tabU.moyenne().afficher(Serial);
+    printf(", minimum ");
+    tabU.minimum().afficher(Serial);
+    printf(", maximum ");
+    tabU.maximum().afficher(Serial);
+    printf(", puissance moyenne ");
+    tabP.moyenne().afficher(Serial);
+    printf("\n%u octets pour %u tensions (objets : %u)\n\n", (unsigned)sizeof(tabU), (unsigned)N,
+           (unsigned)sizeof(objetsU));
+
+    static Jeu jeu;
+    jeu.nom = "256 releves";
+    jeu.n = N;
+    banc::demarrer("Tableaux de grandeurs (par element)", argc, argv);
+    banc::mesurer("objets : etalonnage v * k + d", jeu, [&](const Jeu&, size_t) {
+        etalonnerObjets();
+        return (size_t)(objetsU[0].getValeur() != 0);
+    }, N);
+    banc::mesurer("TableauGrandeurs::affine", jeu, [&](const Jeu&, size_t) {
+        tabU.affine(GAIN, DECALAGE);
+        return (size_t)(tabU[0].getValeur() != 0);
+    }, N);
+    banc::mesurer("objets : u += v", jeu, [&](const Jeu&, size_t) {
+        for (size_t k = 0; k < N; k++) objetsU[k] += objetsV[k];
+        return (size_t)(objetsU[0].getValeur() != 0);
+    }, N);
+    banc::mesurer("TableauGrandeurs : u += v", jeu, [&](const Jeu&, size_t) {
+        tabU += tabV;
+        return (size_t)(tabU[0].getValeur() != 0);
+    }, N);
+    banc::mesurer("objets : p = u * i", jeu, [&](const Jeu&, size_t) {
+        for (size_t k = 0; k < N; k++) objetsP[k] = objetsU[k] * objetsI[k];
+        return (size_t)(objetsP[0].getValeur() != 0);
+    }, N);
+    banc::mesurer("TableauGrandeurs : p = u * i", jeu, [&](const Jeu&, size_t) {
+        tabP = tabU * tabI;
+        return (size_t)(tabP[0].getValeur() != 0);
+    }, N);
+    banc::mesurer("objets : somme", jeu, [&](const Jeu&, size_t) {
+        return (size_t)(sommeObjets().getValeur() != 0);
+    }, N);
+    banc::mesurer("TableauGrandeurs::somme", jeu, [&](const Jeu&, size_t) {
+        return (size_t)(tabU.somme().getValeur() != 0);
+    }, N);
+    banc::mesurer("objets : minimum et maximum", jeu, [&](const Jeu&, size_t) {
+        return (size_t)(minimumObjets() < maximumObjets());
+    }, N);
+    banc::mesurer("TableauGrandeurs : minimum et maximum", jeu, [&](const Jeu&, size_t) {
+        return (size_t)(tabU.minimum() < tabU.maximum());
+    }, N);
+    banc::mesurer("objets : afficher un par un", jeu, [&](const Jeu&, size_t) {
+        return afficherObjets(texteObjets, sizeof(texteObjets));
+    }, N);
+    banc::mesurer("TableauGrandeurs::afficher", jeu, [&](const Jeu&, size_t) {
+        return tabU.afficher(texte, sizeof(texte));
+    }, N);
+    banc::terminer();
+    return !juste || banc::puits == 0;
+}
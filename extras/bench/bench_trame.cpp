@@ -0,0 +1,232 @@
+// bench_trame.cpp - Banc d'essai des trames binaires de télémétrie
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Relevés typiques d'un nœud LoRa / RS-485 (tension, courant,
+//              puissance, température, humidité, pression, fréquence, CO2)
+//              envoyés par trames de 16 mesures : en texte (valeurAvecUnite,
+//              séparées par ';') et en binaire (EcritureTrame) en FLOAT32,
+//              FLOAT16 et entiers à l'échelle. Compare les octets par mesure,
+//              le débit d'encodage et de décodage, et vérifie l'aller-retour.
+//              Usage : bench_trame [resultats.csv]
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include "banc.h"
+
+using banc::Jeu;
+
+typedef EcritureTrame<RepertoireSI> Ecriture;
+typedef LectureTrame<RepertoireSI> Lecture;
+
+static const size_t MESURES_PAR_TRAME = 16;
+static const size_t TAILLE_TRAME = 256;
+
+/**
+ * Grandeur relevée : plage des valeurs et résolution utile (exposant de
+ * l'entier à l'échelle, choisi pour tenir sur 16 bits)
+ */
+struct Releve {
+    uint8_t unite;
+    float min, max;
+    int exposant;
+};
+
+static const Releve RELEVES[] = {
+    { RepertoireSI::identifiant<Tension>(),               0.0f,   48.0f, -2 },
+    { RepertoireSI::identifiant<Courant>(),               0.0f,    5.0f, -3 },
+    { RepertoireSI::identifiant<Puissance>(),             0.0f, 2000.0f, -1 },
+    { RepertoireSI::identifiant<Temperature>(),         -20.0f,   60.0f, -2 },
+    { RepertoireSI::identifiant<Humidite>(),              0.0f,  100.0f, -1 },
+    { RepertoireSI::identifiant<PressionAtmospherique>(), 950.0f, 1050.0f, -1 },
+    { RepertoireSI::identifiant<Frequence>(),            49.5f,   50.5f, -2 },
+    { RepertoireSI::identifiant<CO2>(),                 400.0f, 5000.0f,  0 },
+};
+static const size_t NB_RELEVES = sizeof(RELEVES) / sizeof(RELEVES[0]);
+
+struct Corpus {
+    uint8_t genres[banc::TAILLE_JEU];  // Indice dans RELEVES
+    float valeurs[banc::TAILLE_JEU];
+    uint32_t instants[banc::TAILLE_JEU];
+};
+
+static void remplirCorpus(Corpus& c) {
+    uint32_t instant = 0;
+    for (size_t i = 0; i < banc::TAILLE_JEU; i++) {
+        const Releve& r = RELEVES[i % NB_RELEVES];
+        c.genres[i] = (uint8_t)(i % NB_RELEVES);
+        c.valeurs[i] = r.min + (r.max - r.min) * (float)(banc::aleatoire() % 10000) / 10000.0f;
+        if (i % NB_RELEVES == 0) instant += 1000 + banc::aleatoire() % 50; // Un cycle de relevés par seconde
+        c.instants[i] = instant;
+    }
+}
+
+static Corpus corpus;
+
+// ============================================================================
+// TEXTE ET BINAIRE
+// ============================================================================
+
+// Mesures [debut, debut + 16[ en texte : " 12.50V; 1.235A; ..."
+static size_t trameTexte(char* out, size_t cap, size_t debut) {
+    size_t len = 0;
+    for (size_t k = debut; k < debut + MESURES_PAR_TRAME; k++) {
+        if (k > debut && len + 1 < cap) out[len++] = ';';
+        uint8_t unite = RELEVES[corpus.genres[k]].unite;
+        len += C_UNITY::valeurAvecUnite(out + len, cap - len, corpus.valeurs[k], RepertoireSI::symbole(unite), 2);
+    }
+    return len;
+}
+
+// Idem en binaire ; codage ENTIER16 : exposant propre à chaque grandeur
+static size_t trameBinaire(uint8_t* out, size_t cap, size_t debut, uint8_t codage, bool horodatee) {
+    Ecriture e(out, cap);
+    for (size_t k = debut; k < debut + MESURES_PAR_TRAME; k++) {
+        const Releve& r = RELEVES[corpus.genres[k]];
+        if (horodatee) e.horodater(corpus.instants[k]);
+        e.ajouter(r.unite, corpus.valeurs[k], codage, r.exposant);
+    }
+    return e.taille();
+}
+
+static size_t lireTexte(const char* texte, size_t n, float* valeurs, uint8_t* unites) {
+    size_t lues = 0;
+    const char* fin = texte + n;
+    while (texte < fin) {
+        const char* separateur = (const char*)memchr(texte, ';', (size_t)(fin - texte));
+        if (!separateur) separateur = fin;
+        if (RepertoireSI::lire(texte, separateur, valeurs[lues], unites[lues])) lues++;
+        texte = separateur + 1;
+    }
+    return lues;
+}
+
+static size_t lireBinaire(const uint8_t* trame, size_t n, float* valeurs, uint8_t* unites) {
+    Lecture l(trame, n);
+    MesureTrame m;
+    size_t lues = 0;
+    while (l.suivante(m)) {
+        valeurs[lues] = m.valeur<float>();
+        unites[lues++] = m.unite;
+    }
+    return lues;
+}
+
+/**
+ * Aller-retour : même classe et valeur à la résolution du codage près.
+ * Le texte perd la classe quand un symbole préfixé est celui d'une autre
+ * classe : "1.04kW" est relu DemandeMax (déclarée en kW), pas Puissance
+ */
+static size_t verifier(const float* valeurs, const uint8_t* unites, size_t n, size_t debut, float tolerance) {
+    size_t justes = 0;
+    for (size_t k = 0; k < n; k++) {
+        const Releve& r = RELEVES[corpus.genres[debut + k]];
+        float attendu = corpus.valeurs[debut + k];
+        if (unites[k] == r.unite && fabsf(valeurs[k] - attendu) <= tolerance * fabsf(attendu) + 0.5f * TrameUnity::decaler(1.0, r.exposant))
+            justes++;
+    }
+    return justes;
+}
+
+int main(int argc, char** argv) {
+    remplirCorpus(corpus);
+    static char texte[TAILLE_TRAME];
+    static uint8_t trame[TAILLE_TRAME];
+    static float valeurs[MESURES_PAR_TRAME];
+    static uint8_t unites[MESURES_PAR_TRAME];
+
+    // Octets par mesure et aller-retour, sur tout le corpus
+    struct Format {
+        const char* nom;
+        uint8_t codage;
+        bool horodatee;
+        float tolerance;  // Écart relatif admis
+    };
+    const Format formats[] = {
+        { "binaire FLOAT32",           TrameUnity::FLOAT32,  false, 1e-7f },
+        { "binaire FLOAT16",           TrameUnity::FLOAT16,  false, 1e-3f },
+        { "binaire ENTIER16",          TrameUnity::ENTIER16, false, 1e-7f },
+        { "binaire ENTIER16 horodate", TrameUnity::ENTIER16, true,  1e-7f },
+    };
+    printf("%-28s %12s %12s\n", "format", "octets/mes.", "relues");
+    size_t octets = 0, justes = 0;
+    for (size_t debut = 0; debut < banc::TAILLE_JEU; debut += MESURES_PAR_TRAME) {
+        size_t n = trameTexte(texte, sizeof(texte), debut);
+        octets += n;
+        justes += verifier(valeurs, unites, lireTexte(texte, n, valeurs, unites), debut, 5e-3f);
+    }
+    printf("%-28s %12.2f %8u/%u\n", "texte (2 decimales)", (double)octets / banc::TAILLE_JEU,
+           (unsigned)justes, (unsigned)banc::TAILLE_JEU);
+    bool binaireJuste = true;
+    for (const Format& f : formats) {
+        octets = justes = 0;
+        for (size_t debut = 0; debut < banc::TAILLE_JEU; debut += MESURES_PAR_TRAME) {
+            size_t n = trameBinaire(trame, sizeof(trame), debut, f.codage, f.horodatee);
+            octets += n;
+            justes += verifier(valeurs, unites, lireBinaire(trame, n, valeurs, unites), debut, f.tolerance);
+        }
+        printf("%-28s %12.2f %8u/%u\n", f.nom, (double)octets / banc::TAILLE_JEU, (unsigned)justes, (unsigned)banc::TAILLE_JEU);
+        binaireJuste = binaireJuste && justes == banc::TAILLE_JEU;
+    }
+    printf("\n");
+
+    // Débit : une trame de 16 mesures par appel
+    static Jeu jeu;
+    jeu.nom = "releves";
+    jeu.n = banc::TAILLE_JEU;
+    banc::demarrer("Trames de telemetrie (16 mesures)", argc, argv);
+    banc::mesurer("encodage texte", jeu, [&](const Jeu&, size_t i) {
+        return trameTexte(texte, sizeof(texte), i);
+    }, MESURES_PAR_TRAME);
+    banc::mesurer("encodage FLOAT32", jeu, [&](const Jeu&, size_t i) {
+        return trameBinaire(trame, sizeof(trame), i, TrameUnity::FLOAT32, false);
+    }, MESURES_PAR_TRAME);
+    banc::mesurer("encodage FLOAT16", jeu, [&](const Jeu&, size_t i) {
+        return trameBinaire(trame, sizeof(trame), i, TrameUnity::FLOAT16, false);
+    }, MESURES_PAR_TRAME);
+    banc::mesurer("encodage ENTIER16 horodate", jeu, [&](const Jeu&, size_t i) {
+        return trameBinaire(trame, sizeof(trame), i, TrameUnity::ENTIER16, true);
+    }, MESURES_PAR_TRAME);
+
+    // Décodage de trames préparées, une par position de départ
+    static char textes[banc::TAILLE_JEU / MESURES_PAR_TRAME][TAILLE_TRAME];
+    static size_t longueursTexte[banc::TAILLE_JEU / MESURES_PAR_TRAME];
+    static uint8_t trames[3][banc::TAILLE_JEU / MESURES_PAR_TRAME][TAILLE_TRAME];
+    static size_t longueurs[3][banc::TAILLE_JEU / MESURES_PAR_TRAME];
+    const uint8_t codages[3] = { TrameUnity::FLOAT32, TrameUnity::FLOAT16, TrameUnity::ENTIER16 };
+    for (size_t t = 0; t < banc::TAILLE_JEU / MESURES_PAR_TRAME; t++) {
+        longueursTexte[t] = trameTexte(textes[t], TAILLE_TRAME, t * MESURES_PAR_TRAME);
+        for (int c = 0; c < 3; c++) longueurs[c][t] = trameBinaire(trames[c][t], TAILLE_TRAME, t * MESURES_PAR_TRAME, codages[c], true);
+    }
+
+    banc::mesurer("decodage texte (RepertoireSI::lire)", jeu, [&](const Jeu&, size_t i) {
+        size_t t = i / MESURES_PAR_TRAME;
+        return lireTexte(textes[t], longueursTexte[t], valeurs, unites);
+    }, MESURES_PAR_TRAME);
+    const char* noms[3] = { "decodage FLOAT32", "decodage FLOAT16", "decodage ENTIER16 horodate" };
+    for (int c = 0; c < 3; c++) {
+        banc::mesurer(noms[c], jeu, [&](const Jeu&, size_t i) {
+            size_t t = i / MESURES_PAR_TRAME;
+            return lireBinaire(trames[c][t], longueurs[c][t], valeurs, unites);
+        }, MESURES_PAR_TRAME);
+    }
+    banc::mesurer("decodage ENTIER16 -> Tension", jeu, [&](const Jeu&, size_t i) {
+        size_t t = i / MESURES_PAR_TRAME;
+        Lecture l(trames[2][t], longueurs[2][t]);
+        MesureTrame m;
+        Tension v;
+        size_t n = 0;
+        while (l.suivante(m)) n += Lecture::vers(m, v);
+        return n + (v.getValeur() > 0);
+    }, MESURES_PAR_TRAME);
+    banc::mesurer("decodage ENTIER16 -> texte", jeu, [&](const Jeu&, size_t i) {
+        size_t t = i / MESURES_PAR_TRAME;
+        Lecture l(trames[2][t], longueurs[2][t]);
+        MesureTrame m;
+        size_t n = 0;
+        while (l.suivante(m)) n += Lecture::afficher(m, texte, sizeof(texte), 2);
+        return n;
+    }, MESURES_PAR_TRAME);
+    banc::terminer();
+    return !binaireJuste || banc::puits == 0;
+}
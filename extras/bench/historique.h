@@ -0,0 +1,107 @@
+// historique.h - Formatage de la version 1.0.0 (référence du banc d'essai)
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Copie à l'identique de C_UNITY::valeurAvecUnite avant le passage
+//              au tampon et à la table de préfixes, et de C_UNITY::formatNombre,
+//              pour comparer les mesures à la version d'origine sur la même
+//              machine.
+
+#ifndef UNITY_BANC_HISTORIQUE_H
+#define UNITY_BANC_HISTORIQUE_H
+
+#include <Arduino.h>
+
+namespace historique {
+
+inline String valeurAvecUnite(float val, String unite, int nbDecimal = 3, bool espaceAvantUnite = true) {
+    String result;
+    if (espaceAvantUnite) result = " ";
+    else result = "";
+
+    // Gestion des valeurs négatives
+    bool isNegative = val < 0;
+    if (isNegative) {
+        result += "-";
+        val = -val;
+    }
+
+    // Valeur nulle
+    if (val == 0.0) {
+        result += "0.0";
+        result += unite;
+        return result;
+    }
+
+    // Conversion avec préfixes (multiplication par l'inverse pour optimisation)
+    if (val >= 1.0e12) {
+        result += String(val * 1.0e-12, nbDecimal);
+        result += "T" + unite;
+    } else if (val >= 1.0e9) {
+        result += String(val * 1.0e-9, nbDecimal);
+        result += "G" + unite;
+    } else if (val >= 1.0e6) {
+        result += String(val * 1.0e-6, nbDecimal);
+        result += "M" + unite;
+    } else if (val >= 1.0e3) {
+        result += String(val * 1.0e-3, nbDecimal);
+        result += "k" + unite;
+    } else if (val >= 1.0) {
+        result += String(val, nbDecimal);
+        result += unite;
+    } else if (val >= 1.0e-3) {
+        result += String(val * 1.0e3, nbDecimal);
+        result += "m" + unite;
+    } else if (val >= 1.0e-6) {
+        result += String(val * 1.0e6, nbDecimal);
+        result += "µ" + unite;
+    } else if (val >= 1.0e-9) {
+        result += String(val * 1.0e9, nbDecimal);
+        result += "n" + unite;
+    } else if (val >= 1.0e-12) {
+        result += String(val * 1.0e12, nbDecimal);
+        result += "p" + unite;
+    } else if (val >= 1.0e-15) {
+        result += String(val * 1.0e15, nbDecimal);
+        result += "f" + unite;
+    } else if (val >= 1.0e-18) {
+        result += String(val * 1.0e18, nbDecimal);
+        result += "a" + unite;
+    } else {
+        // Valeur trop petite
+        result += "ε"; // GREEK SMALL LETTER EPSILON , code UTF-8 : 0xCEB5
+        result += unite;
+    }
+
+    return result;
+}
+
+inline String formatNombre(float valeur, int decimales = 0, char separateur = ' ') {
+    String result = String(valeur, decimales);
+    
+    int pointIndex = result.indexOf('.');
+    if (pointIndex == -1) pointIndex = result.length();
+    
+    String partieEntiere = result.substring(0, pointIndex);
+    String partieDecimale = ((unsigned int)pointIndex < result.length()) ? result.substring(pointIndex) : "";
+    
+    String formatted = "";
+    int count = 0;
+    for (int i = partieEntiere.length() - 1; i >= 0; i--) {
+        if (partieEntiere[i] == '-') {
+            formatted = "-" + formatted;
+            break;
+        }
+        formatted = String(partieEntiere[i]) + formatted;
+        count++;
+        if (count == 3 && i > 0 && partieEntiere[i-1] != '-') {
+            formatted = String(separateur) + formatted;
+            count = 0;
+        }
+    }
+    
+    return formatted + partieDecimale;
+}
+
+} // namespace historique
+
+#endif // UNITY_BANC_HISTORIQUE_H
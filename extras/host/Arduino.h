@@ -0,0 +1,207 @@
+// Arduino.h (hôte) - Substitut minimal de l'environnement Arduino pour PC
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Permet de compiler Unity.h et valeurs_SI.h sur PC (Linux, macOS)
+//              pour profiler le formatage. Fournit String, Print, Serial, F(),
+//              PROGMEM et les fonctions de temps, avec un compteur d'allocations
+//              sur le tas pour mesurer le coût mémoire de chaque appel.
+
+#ifndef UNITY_HOTE_ARDUINO_H
+#define UNITY_HOTE_ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+
+// ============================================================================
+// COMPTEUR D'ALLOCATIONS (TAS)
+// ============================================================================
+
+namespace hote {
+
+struct CompteurTas {
+    unsigned long allocations;  // Nombre d'appels malloc/realloc
+    unsigned long octets;       // Octets demandés
+};
+
+inline CompteurTas& compteurTas() {
+    static CompteurTas compteur = { 0, 0 };
+    return compteur;
+}
+
+inline void* allouer(void* ancien, size_t taille) {
+    compteurTas().allocations++;
+    compteurTas().octets += taille;
+    return realloc(ancien, taille);
+}
+
+} // namespace hote
+
+// ============================================================================
+// MÉMOIRE FLASH (SANS OBJET SUR PC)
+// ============================================================================
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(adr) (*(const uint8_t*)(adr))
+#define pgm_read_word(adr) (*(const uint16_t*)(adr))
+#define pgm_read_dword(adr) (*(const uint32_t*)(adr))
+#define pgm_read_float(adr) (*(const float*)(adr))
+#define pgm_read_ptr(adr) (*(const void* const*)(adr))
+
+class __FlashStringHelper;
+#define F(chaine) (reinterpret_cast<const __FlashStringHelper*>(PSTR(chaine)))
+
+// ============================================================================
+// CLASSE String (MÊME POLITIQUE D'ALLOCATION QUE WString.cpp)
+// ============================================================================
+
+class String {
+    char* tampon;
+    unsigned int capacite;
+    unsigned int longueur;
+
+    // Comme WString : réallocation à la taille exacte dès que la capacité manque
+    bool reserver(unsigned int taille) {
+        if (tampon && capacite >= taille) return true;
+        char* nouveau = (char*)hote::allouer(tampon, taille + 1);
+        if (!nouveau) return false;
+        if (!tampon) nouveau[0] = '\0';
+        tampon = nouveau;
+        capacite = taille;
+        return true;
+    }
+
+    void copier(const char* s, unsigned int n) {
+        if (!reserver(n)) return;
+        memcpy(tampon, s, n);
+        tampon[n] = '\0';
+        longueur = n;
+    }
+
+public:
+    String() : tampon(nullptr), capacite(0), longueur(0) { copier("", 0); }
+    String(const char* s) : tampon(nullptr), capacite(0), longueur(0) { if (s) copier(s, strlen(s)); }
+    String(const __FlashStringHelper* s) : String(reinterpret_cast<const char*>(s)) {}
+    String(const String& s) : tampon(nullptr), capacite(0), longueur(0) { copier(s.c_str(), s.longueur); }
+    String(char c) : tampon(nullptr), capacite(0), longueur(0) { copier(&c, 1); }
+    String(int v) : String((long)v) {}
+    String(unsigned int v) : String((unsigned long)v) {}
+    String(long v) : tampon(nullptr), capacite(0), longueur(0) { char b[24]; copier(b, snprintf(b, sizeof(b), "%ld", v)); }
+    String(unsigned long v) : tampon(nullptr), capacite(0), longueur(0) { char b[24]; copier(b, snprintf(b, sizeof(b), "%lu", v)); }
+    String(float v, unsigned char decimales = 2) : String((double)v, decimales) {}
+    String(double v, unsigned char decimales = 2) : tampon(nullptr), capacite(0), longueur(0) {
+        char b[352];  // dtostrf : largeur decimales + 2
+        copier(b, snprintf(b, sizeof(b), "%*.*f", decimales + 2, decimales, v));
+    }
+    ~String() { free(tampon); }
+
+    String& operator=(const String& s) { if (this != &s) copier(s.c_str(), s.longueur); return *this; }
+    String& operator=(const char* s) { copier(s, strlen(s)); return *this; }
+
+    bool reserve(unsigned int taille) { return reserver(taille); }
+    unsigned int length() const { return longueur; }
+    const char* c_str() const { return tampon ? tampon : ""; }
+
+    bool concat(const char* s, unsigned int n) {
+        if (!reserver(longueur + n)) return false;
+        memcpy(tampon + longueur, s, n);
+        longueur += n;
+        tampon[longueur] = '\0';
+        return true;
+    }
+    bool concat(const char* s) { return concat(s, strlen(s)); }
+    bool concat(const String& s) { return concat(s.c_str(), s.longueur); }
+    bool concat(char c) { return concat(&c, 1); }
+
+    String& operator+=(const String& s) { concat(s); return *this; }
+    String& operator+=(const char* s) { concat(s); return *this; }
+    String& operator+=(const __FlashStringHelper* s) { concat(reinterpret_cast<const char*>(s)); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+
+    friend String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+
+    char operator[](unsigned int i) const { return i < longueur ? tampon[i] : '\0'; }
+    bool operator==(const String& s) const { return longueur == s.longueur && strcmp(c_str(), s.c_str()) == 0; }
+    bool operator==(const char* s) const { return strcmp(c_str(), s) == 0; }
+    bool operator!=(const String& s) const { return !(*this == s); }
+
+    int indexOf(char c) const {
+        const char* p = strchr(c_str(), c);
+        return p ? (int)(p - c_str()) : -1;
+    }
+
+    String substring(unsigned int debut, unsigned int fin) const {
+        if (fin > longueur) fin = longueur;
+        if (debut >= fin) return String();
+        String r;
+        r.copier(tampon + debut, fin - debut);
+        return r;
+    }
+    String substring(unsigned int debut) const { return substring(debut, longueur); }
+};
+
+// ============================================================================
+// CLASSE Print ET Serial
+// ============================================================================
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t taille) {
+        size_t n = 0;
+        while (taille--) n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t write(const char* buffer, size_t taille) { return write((const uint8_t*)buffer, taille); }
+    virtual void flush() {}
+
+    size_t print(const char* s) { return write(s); }
+    size_t print(const String& s) { return write(s.c_str(), s.length()); }
+    size_t print(const __FlashStringHelper* s) { return print(reinterpret_cast<const char*>(s)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v) { return print((long)v); }
+    size_t print(long v) { char b[24]; return write(b, snprintf(b, sizeof(b), "%ld", v)); }
+    size_t print(unsigned long v) { char b[24]; return write(b, snprintf(b, sizeof(b), "%lu", v)); }
+    size_t print(double v, int decimales = 2) { char b[352]; return write(b, snprintf(b, sizeof(b), "%.*f", decimales, v)); }
+
+    size_t println() { return write("\r\n"); }
+    template <class T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    size_t println(double v, int decimales) { size_t n = print(v, decimales); return n + println(); }
+};
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long) {}
+    using Print::write;
+    size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+    size_t write(const uint8_t* buffer, size_t taille) override { return fwrite(buffer, 1, taille, stdout); }
+    void flush() override { fflush(stdout); }
+};
+
+static HardwareSerial Serial;
+
+// ============================================================================
+// TEMPS ET DIVERS
+// ============================================================================
+
+inline unsigned long micros() {
+    static const std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - debut).count();
+}
+
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long) {}
+inline long random(long min, long max) { return min + rand() % (max - min); }
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+#endif // UNITY_HOTE_ARDUINO_H
@@ -0,0 +1,13 @@
+// principal.cpp (hôte) - Point d'entrée des croquis compilés sur PC
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Appelle setup() puis un tour de loop(), comme la carte au démarrage.
+
+void setup();
+void loop();
+
+int main() {
+    setup();
+    loop();
+    return 0;
+}
@@ -0,0 +1,247 @@
+// formateur_csv.h - Mise en forme de journaux CSV sur PC, en parallèle
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Remplace chaque colonne numérique d'un journal CSV par le texte
+//              que produirait la carte (valeurAvecUnite, formatNombre), avec
+//              la classe de la colonne donnée par son symbole dans
+//              RepertoireSI. Le texte est découpé en blocs aux fins de ligne,
+//              formatés par plusieurs threads et rendus dans l'ordre.
+//              Utilisé par unity_csv et bench_csv.
+
+#ifndef UNITY_FORMATEUR_CSV_H
+#define UNITY_FORMATEUR_CSV_H
+
+#include <Arduino.h>
+#include "Unity.h"
+#include "valeurs_SI.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace csv {
+
+// ============================================================================
+// BLOC DE SORTIE
+// ============================================================================
+
+/**
+ * Texte formaté d'un bloc : tableau qui grandit par doublement, écrit
+ * directement par les fonctions à tampon de la librairie
+ */
+class SortieBloc {
+public:
+    SortieBloc() : n(0) {}
+
+    // Place pour au moins k octets à la fin du texte
+    char* reserver(size_t k) {
+        if (n + k > octets.size()) octets.resize((n + k) * 2);
+        return &octets[n];
+    }
+
+    void avancer(size_t k) { n += k; }
+
+    void ajouter(const char* p, size_t k) {
+        memcpy(reserver(k), p, k);
+        n += k;
+    }
+
+    void ajouter(char c) {
+        *reserver(1) = c;
+        n++;
+    }
+
+    void effacer() { n = 0; }
+    const char* donnees() const { return octets.empty() ? "" : &octets[0]; }
+    size_t taille() const { return n; }
+
+private:
+    std::vector<char> octets;
+    size_t n;
+};
+
+// ============================================================================
+// FORMATEUR
+// ============================================================================
+
+/**
+ * Colonnes décrites par une liste de symboles de RepertoireSI :
+ *
+ *   csv::FormateurCSV f;
+ *   f.colonnes("-,V,A,W,#");    // Recopiée, Tension, Courant, Puissance, formatNombre
+ *   f.formater(texte, fin, sortie);
+ *   f.traiter(texte, taille, 8, [](const char* p, size_t n) { fwrite(p, 1, n, stdout); });
+ *
+ * Un champ est relu comme par lire() de sa classe ("4700", "4.7k" ou
+ * "4.7kΩ") puis réécrit en float, comme sur la carte ; un champ illisible
+ * (horodatage, texte, vide) et les colonnes au-delà de la liste sont
+ * recopiés. Les fins de ligne \r\n sont conservées.
+ */
+class FormateurCSV {
+public:
+    static const uint8_t RECOPIE = 0xFF;  // '-' : champ recopié
+    static const uint8_t NOMBRE = 0xFE;   // '#' : formatNombre (séparateur de milliers)
+    static const size_t NB_COLONNES_MAX = 64;
+
+    char separateur;        // Séparateur de colonnes (entrée et sortie)
+    int nbDecimal;          // Décimales de valeurAvecUnite
+    int decimalesNombre;    // Décimales des colonnes '#'
+    bool espace;            // Espace entre le nombre et l'unité
+    bool entete;            // Première ligne recopiée
+    size_t tailleBloc;      // Octets par bloc (arrondi à la fin de ligne suivante)
+
+    FormateurCSV()
+        : separateur(','), nbDecimal(3), decimalesNombre(0), espace(true), entete(false),
+          tailleBloc(1 << 20), nbColonnes(0) {}
+
+    /**
+     * Classe de chaque colonne, séparées par des virgules : symbole de
+     * RepertoireSI ("V", "kWh", "°C"), '-' ou '#'.
+     * Retourne nullptr, ou le premier symbole inconnu de la liste
+     */
+    const char* colonnes(const char* liste) {
+        nbColonnes = 0;
+        const char* p = liste;
+        while (*p && nbColonnes < NB_COLONNES_MAX) {
+            const char* fin = strchr(p, ',');
+            if (!fin) fin = p + strlen(p);
+            size_t n = (size_t)(fin - p);
+            uint8_t id;
+            if (n == 1 && *p == '-') id = RECOPIE;
+            else if (n == 1 && *p == '#') id = NOMBRE;
+            else if ((id = RepertoireSI::chercher(p, n)) == RepertoireSI::AUCUNE) return p;
+            classes[nbColonnes++] = id;
+            p = *fin ? fin + 1 : fin;
+        }
+        return nullptr;
+    }
+
+    // Lignes complètes [debut, fin[ mises en forme à la suite de sortie
+    void formater(const char* debut, const char* fin, SortieBloc& sortie) const {
+        const char* p = debut;
+        while (p < fin) {
+            const char* eol = static_cast<const char*>(memchr(p, '\n', (size_t)(fin - p)));
+            if (!eol) eol = fin;
+            const char* finLigne = eol > p && eol[-1] == '\r' ? eol - 1 : eol;
+            size_t colonne = 0;
+            for (const char* c = p;; colonne++) {
+                const char* f = static_cast<const char*>(memchr(c, separateur, (size_t)(finLigne - c)));
+                if (!f) f = finLigne;
+                formaterChamp(c, f, colonne < nbColonnes ? classes[colonne] : RECOPIE, sortie);
+                if (f == finLigne) break;
+                sortie.ajouter(separateur);
+                c = f + 1;
+            }
+            sortie.ajouter(finLigne, (size_t)(eol - finLigne));  // "\r" éventuel
+            if (eol == fin) break;
+            sortie.ajouter('\n');
+            p = eol + 1;
+        }
+    }
+
+    /**
+     * Met en forme [donnees, donnees + taille[ avec nbThreads threads et
+     * appelle ecrire(p, n) dans l'ordre du texte, depuis le thread appelant.
+     * Au plus 2 x nbThreads blocs formatés attendent leur écriture : la
+     * mémoire ne dépend pas de la taille du journal
+     */
+    template <class Ecrire>
+    void traiter(const char* donnees, size_t taille, unsigned nbThreads, Ecrire ecrire) const {
+        const char* fin = donnees + taille;
+        if (entete && taille) {
+            const char* eol = static_cast<const char*>(memchr(donnees, '\n', taille));
+            const char* suite = eol ? eol + 1 : fin;
+            ecrire(donnees, (size_t)(suite - donnees));
+            donnees = suite;
+        }
+
+        // Blocs de tailleBloc octets, prolongés jusqu'à la fin de ligne
+        std::vector<const char*> bornes(1, donnees);
+        while (bornes.back() < fin) {
+            const char* b = bornes.back();
+            if ((size_t)(fin - b) <= tailleBloc) {
+                b = fin;
+            } else {
+                b = static_cast<const char*>(memchr(b + tailleBloc, '\n', (size_t)(fin - b - tailleBloc)));
+                b = b ? b + 1 : fin;
+            }
+            bornes.push_back(b);
+        }
+        const size_t nbBlocs = bornes.size() - 1;
+
+        if (nbThreads <= 1 || nbBlocs <= 1) {
+            SortieBloc sortie;
+            for (size_t i = 0; i < nbBlocs; i++) {
+                sortie.effacer();
+                formater(bornes[i], bornes[i + 1], sortie);
+                ecrire(sortie.donnees(), sortie.taille());
+            }
+            return;
+        }
+
+        // Bloc i formaté dans la case i % fenetre, libérée à son écriture
+        const size_t fenetre = 2 * (size_t)nbThreads;
+        std::vector<SortieBloc> sorties(fenetre);
+        std::vector<char> pret(fenetre, 0);
+        std::mutex verrou;
+        std::condition_variable signal;
+        size_t prochain = 0, ecrits = 0;
+
+        std::vector<std::thread> ouvriers;
+        for (unsigned t = 0; t < nbThreads; t++) {
+            ouvriers.push_back(std::thread([&] {
+                for (;;) {
+                    size_t i;
+                    {
+                        std::unique_lock<std::mutex> l(verrou);
+                        signal.wait(l, [&] { return prochain >= nbBlocs || prochain < ecrits + fenetre; });
+                        if (prochain >= nbBlocs) return;
+                        i = prochain++;
+                    }
+                    SortieBloc& sortie = sorties[i % fenetre];
+                    sortie.effacer();
+                    formater(bornes[i], bornes[i + 1], sortie);
+                    std::lock_guard<std::mutex> l(verrou);
+                    pret[i % fenetre] = 1;
+                    signal.notify_all();
+                }
+            }));
+        }
+        for (size_t i = 0; i < nbBlocs; i++) {
+            {
+                std::unique_lock<std::mutex> l(verrou);
+                signal.wait(l, [&] { return pret[i % fenetre] != 0; });
+            }
+            ecrire(sorties[i % fenetre].donnees(), sorties[i % fenetre].taille());
+            std::lock_guard<std::mutex> l(verrou);
+            pret[i % fenetre] = 0;
+            ecrits++;
+            signal.notify_all();
+        }
+        for (size_t t = 0; t < ouvriers.size(); t++) ouvriers[t].join();
+    }
+
+private:
+    uint8_t classes[NB_COLONNES_MAX];
+    size_t nbColonnes;
+
+    void formaterChamp(const char* debut, const char* fin, uint8_t classe, SortieBloc& sortie) const {
+        float val;
+        if (classe == RECOPIE || debut == fin) {
+            sortie.ajouter(debut, (size_t)(fin - debut));
+        } else if (classe == NOMBRE) {
+            if (!C_UNITY_BASE::lireAvecUnite(debut, fin, F(""), val)) return sortie.ajouter(debut, (size_t)(fin - debut));
+            const size_t cap = 128;  // 39 chiffres de FLT_MAX, séparateurs et décimales
+            sortie.avancer(C_UNITY_BASE::formatNombre(sortie.reserver(cap), cap, val, decimalesNombre));
+        } else {
+            const __FlashStringHelper* symbole = RepertoireSI::symbole(classe);
+            if (!C_UNITY_BASE::lireAvecUnite(debut, fin, symbole, val)) return sortie.ajouter(debut, (size_t)(fin - debut));
+            const size_t cap = 64;
+            sortie.avancer(C_UNITY_BASE::valeurAvecUnite(sortie.reserver(cap), cap, val, symbole, nbDecimal, espace));
+        }
+    }
+};
+
+} // namespace csv
+
+#endif // UNITY_FORMATEUR_CSV_H
@@ -0,0 +1,113 @@
+// unity_csv.cpp - Mise en forme de journaux CSV avec préfixes SI (PC)
+// Auteur: [FOURNET Olivier]
+// Licence: GPL-3.0 license
+// Description: Relit un journal CSV de mesures brutes, projeté en mémoire
+//              (mmap), et le réécrit avec le formatage de la carte
+//              (valeurAvecUnite, formatNombre), colonne par colonne, sur
+//              tous les cœurs. La sortie est dans l'ordre des lignes.
+//
+//   unity_csv -u -,V,A,W,Hz,# releve.csv > rapport.csv
+//   unity_csv -u -,°C,% -s ';' -d 1 -t releve.csv rapport.csv
+//
+// Options :
+//   -u liste   classe de chaque colonne : symbole de RepertoireSI, '-'
+//              (recopiée) ou '#' (formatNombre) ; les suivantes sont recopiées
+//   -s c       séparateur de colonnes (',' par défaut)
+//   -d n       décimales de valeurAvecUnite (3)
+//   -n n       décimales des colonnes '#' (0)
+//   -c         pas d'espace entre le nombre et l'unité
+//   -t         première ligne (titres) recopiée
+//   -j n       nombre de threads (tous les cœurs par défaut)
+//   -b ko      taille des blocs (1024 ko)
+//   -v         débit sur stderr
+
+#include "formateur_csv.h"
+#include <chrono>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int usage() {
+    fprintf(stderr, "Usage : unity_csv -u -,V,A,# [-s c] [-d n] [-n n] [-c] [-t] [-j n] [-b ko] [-v] entree.csv [sortie]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    csv::FormateurCSV formateur;
+    unsigned nbThreads = std::thread::hardware_concurrency();
+    bool bavard = false, colonnes = false;
+    int option;
+    while ((option = getopt(argc, argv, "u:s:d:n:ctj:b:v")) != -1) {
+        switch (option) {
+        case 'u': {
+            const char* inconnu = formateur.colonnes(optarg);
+            if (inconnu) {
+                fprintf(stderr, "unity_csv : symbole inconnu de RepertoireSI : %.*s\n", (int)strcspn(inconnu, ","), inconnu);
+                return 2;
+            }
+            colonnes = true;
+            break;
+        }
+        case 's': formateur.separateur = optarg[0]; break;
+        case 'd': formateur.nbDecimal = atoi(optarg); break;
+        case 'n': formateur.decimalesNombre = atoi(optarg); break;
+        case 'c': formateur.espace = false; break;
+        case 't': formateur.entete = true; break;
+        case 'j': nbThreads = (unsigned)atoi(optarg); break;
+        case 'b': formateur.tailleBloc = (size_t)atol(optarg) * 1024; break;
+        case 'v': bavard = true; break;
+        default: return usage();
+        }
+    }
+    if (!colonnes || optind >= argc || argc - optind > 2 || formateur.tailleBloc == 0) return usage();
+    if (nbThreads == 0) nbThreads = 1;
+
+    int fd = open(argv[optind], O_RDONLY);
+    struct stat etat;
+    if (fd < 0 || fstat(fd, &etat) != 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+    FILE* sortie = argc - optind == 2 ? fopen(argv[optind + 1], "wb") : stdout;
+    if (!sortie) {
+        perror(argv[optind + 1]);
+        return 1;
+    }
+
+    // Fichier projeté en lecture : les threads lisent les pages sans copie
+    size_t taille = (size_t)etat.st_size;
+    const char* donnees = "";
+    if (taille) {
+        void* p = mmap(nullptr, taille, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            perror("mmap");
+            return 1;
+        }
+        madvise(p, taille, MADV_SEQUENTIAL);
+        donnees = static_cast<const char*>(p);
+    }
+
+    auto debut = std::chrono::steady_clock::now();
+    size_t ecrits = 0;
+    bool erreur = false;
+    formateur.traiter(donnees, taille, nbThreads, [&](const char* p, size_t n) {
+        if (!erreur && fwrite(p, 1, n, sortie) != n) erreur = true;
+        ecrits += n;
+    });
+    if (fflush(sortie) != 0) erreur = true;
+    double secondes = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+
+    if (taille) munmap(const_cast<char*>(donnees), taille);
+    close(fd);
+    if (sortie != stdout) fclose(sortie);
+    if (erreur) {
+        perror("unity_csv : ecriture");
+        return 1;
+    }
+    if (bavard) {
+        fprintf(stderr, "%.1f Mo lus, %.1f Mo ecrits en %.3f s (%.0f Mo/s, %u threads)\n",
+                taille / 1e6, ecrits / 1e6, secondes, taille / 1e6 / secondes, nbThreads);
+    }
+    return 0;
+}